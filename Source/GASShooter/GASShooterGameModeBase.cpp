@@ -2,18 +2,50 @@
 
 
 #include "GASShooterGameModeBase.h"
+#include "Async/ParallelFor.h"
 #include "Engine/World.h"
+#include "EngineUtils.h"
 #include "Characters/Heroes/GSHeroCharacter.h"
+#include "GASShooterGameStateBase.h"
+#include "GSStats.h"
 #include "Player/GSPlayerController.h"
 #include "Player/GSPlayerState.h"
+#include "GameFramework/PlayerStart.h"
 #include "GameFramework/SpectatorPawn.h"
-#include "Kismet/GameplayStatics.h"
 #include "TimerManager.h"
 #include "UObject/ConstructorHelpers.h"
+#include "WorldCollision.h"
+
+static TAutoConsoleVariable<int32> CVarSpawnTracesPerFrame(
+	TEXT("GS.Spawn.TracesPerFrame"),
+	16,
+	TEXT("Maximum number of spawn point line of sight traces issued per frame")
+);
+
+static TAutoConsoleVariable<int32> CVarSpawnParallelThreshold(
+	TEXT("GS.Spawn.ParallelThreshold"),
+	1024,
+	TEXT("Number of spawn point and enemy pairs at which the distance scoring is split across worker threads")
+);
 
 AGASShooterGameModeBase::AGASShooterGameModeBase()
 {
 	RespawnDelay = 5.0f;
+	SpawnScoringLeadTime = 1.0f;
+
+	EnemySpawnTag = FName("EnemyHeroSpawn");
+	IdealEnemyDistance = 3000.0f;
+	VisibleSpawnPenalty = 1.0f;
+	RecentSpawnPenalty = 0.5f;
+	RecentSpawnTime = 3.0f;
+	EnemiesTracedPerSpawn = 4;
+	NextSpawnScoringRequestId = 1;
+
+	// Only ticks while spawn scoring traces are waiting to be issued
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+
+	GameStateClass = AGASShooterGameStateBase::StaticClass();
 
 	HeroClass = StaticLoadClass(UObject::StaticClass(), nullptr, TEXT("/Game/GASShooter/Characters/Hero/BP_HeroCharacter.BP_HeroCharacter_C"));
 	if (!HeroClass)
@@ -22,6 +54,13 @@ AGASShooterGameModeBase::AGASShooterGameModeBase()
 	}
 }
 
+void AGASShooterGameModeBase::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	IssueSpawnVisibilityTraces();
+}
+
 void AGASShooterGameModeBase::HeroDied(AController* Controller)
 {
 	FActorSpawnParameters SpawnParameters;
@@ -37,6 +76,18 @@ void AGASShooterGameModeBase::HeroDied(AController* Controller)
 	RespawnDelegate = FTimerDelegate::CreateUObject(this, &AGASShooterGameModeBase::RespawnHero, Controller);
 	GetWorldTimerManager().SetTimer(RespawnTimerHandle, RespawnDelegate, RespawnDelay, false);
 
+	FTimerHandle SpawnScoringTimerHandle;
+	FTimerDelegate SpawnScoringDelegate = FTimerDelegate::CreateUObject(this, &AGASShooterGameModeBase::StartSpawnScoring, Controller, true);
+	const float SpawnScoringDelay = RespawnDelay - SpawnScoringLeadTime;
+	if (SpawnScoringDelay > 0.0f)
+	{
+		GetWorldTimerManager().SetTimer(SpawnScoringTimerHandle, SpawnScoringDelegate, SpawnScoringDelay, false);
+	}
+	else
+	{
+		StartSpawnScoring(Controller);
+	}
+
 	AGSPlayerController* PC = Cast<AGSPlayerController>(Controller);
 	if (PC)
 	{
@@ -48,22 +99,7 @@ void AGASShooterGameModeBase::BeginPlay()
 {
 	Super::BeginPlay();
 
-	// Get the enemy hero spawn point
-	TArray<AActor*> Actors;
-	UGameplayStatics::GetAllActorsOfClass(GetWorld(), AActor::StaticClass(), Actors);
-	for (AActor* Actor : Actors)
-	{
-		if (Actor->GetName() == FString("EnemyHeroSpawn"))
-		{
-			EnemySpawnPoint = Actor;
-			break;
-		}
-	}
-
-	if (!EnemySpawnPoint)
-	{
-		UE_LOG(LogTemp, Error, TEXT("%s EnemySpawnPoint is null."), *FString(__FUNCTION__));
-	}
+	CollectSpawnPoints();
 }
 
 void AGASShooterGameModeBase::RespawnHero(AController* Controller)
@@ -76,7 +112,11 @@ void AGASShooterGameModeBase::RespawnHero(AController* Controller)
 	if (Controller->IsPlayerController())
 	{
 		// Respawn player hero
-		AActor* PlayerStart = FindPlayerStart(Controller);
+		AActor* PlayerStart = ChooseSpawnPoint(Controller);
+		if (!PlayerStart)
+		{
+			PlayerStart = FindPlayerStart(Controller);
+		}
 
 		FActorSpawnParameters SpawnParameters;
 		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
@@ -97,10 +137,17 @@ void AGASShooterGameModeBase::RespawnHero(AController* Controller)
 	else
 	{
 		// Respawn AI hero
+		AActor* SpawnPoint = ChooseSpawnPoint(Controller);
+		if (!SpawnPoint)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s No enemy spawn point. Falling back to a player start."), *FString(__FUNCTION__));
+			SpawnPoint = FindPlayerStart(Controller);
+		}
+
 		FActorSpawnParameters SpawnParameters;
 		SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
 
-		AGSHeroCharacter* Hero = GetWorld()->SpawnActor<AGSHeroCharacter>(HeroClass, EnemySpawnPoint->GetActorTransform(), SpawnParameters);
+		AGSHeroCharacter* Hero = GetWorld()->SpawnActor<AGSHeroCharacter>(HeroClass, SpawnPoint->GetActorTransform(), SpawnParameters);
 
 		APawn* OldSpectatorPawn = Controller->GetPawn();
 		Controller->UnPossess();
@@ -108,3 +155,245 @@ void AGASShooterGameModeBase::RespawnHero(AController* Controller)
 		Controller->Possess(Hero);
 	}
 }
+
+void AGASShooterGameModeBase::CollectSpawnPoints()
+{
+	UWorld* World = GetWorld();
+
+	PlayerSpawnPoints.Reset();
+	EnemySpawnPoints.Reset();
+
+	for (TActorIterator<APlayerStart> It(World); It; ++It)
+	{
+		APlayerStart* PlayerStart = *It;
+		if (PlayerStart->PlayerStartTag == EnemySpawnTag || PlayerStart->ActorHasTag(EnemySpawnTag))
+		{
+			EnemySpawnPoints.Add(PlayerStart);
+		}
+		else
+		{
+			PlayerSpawnPoints.Add(PlayerStart);
+		}
+	}
+
+	// The sample map's enemy spawn is a plain Actor found by its name. Look it up directly instead of visiting every Actor.
+	if (World->PersistentLevel)
+	{
+		if (AActor* NamedSpawnPoint = FindObjectFast<AActor>(World->PersistentLevel, EnemySpawnTag))
+		{
+			EnemySpawnPoints.AddUnique(NamedSpawnPoint);
+		}
+	}
+
+	if (EnemySpawnPoints.Num() == 0)
+	{
+		UE_LOG(LogTemp, Error, TEXT("%s No enemy spawn points found."), *FString(__FUNCTION__));
+	}
+}
+
+void AGASShooterGameModeBase::StartSpawnScoring(AController* Controller, bool bQueueTraces)
+{
+	if (!IsValid(Controller))
+	{
+		return;
+	}
+
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSSpawnScoring);
+
+	SpawnScoringRequests.RemoveAllSwap([Controller](const FGSSpawnScoringRequest& Request) { return Request.Controller == Controller; });
+
+	FGSSpawnScoringRequest& Request = SpawnScoringRequests.AddDefaulted_GetRef();
+	Request.RequestId = NextSpawnScoringRequestId++;
+	Request.Controller = Controller;
+
+	TArray<FVector> CandidateLocations;
+	for (const TWeakObjectPtr<AActor>& SpawnPoint : Controller->IsPlayerController() ? PlayerSpawnPoints : EnemySpawnPoints)
+	{
+		if (SpawnPoint.IsValid())
+		{
+			Request.Candidates.Add(SpawnPoint);
+			CandidateLocations.Add(SpawnPoint->GetActorLocation());
+		}
+	}
+
+	TArray<FVector> EnemyLocations;
+	for (TActorIterator<AGSHeroCharacter> It(GetWorld()); It; ++It)
+	{
+		AGSHeroCharacter* Hero = *It;
+		if (Hero->IsAlive() && Hero->GetController() != Controller)
+		{
+			Request.Enemies.Add(Hero);
+			Request.EnemyViewLocations.Add(Hero->GetPawnViewLocation());
+			EnemyLocations.Add(Hero->GetActorLocation());
+		}
+	}
+
+	const int32 NumCandidates = Request.Candidates.Num();
+	const int32 NumEnemies = EnemyLocations.Num();
+	constexpr int32 MaxEnemiesTraced = 8;
+	const int32 NumTraced = bQueueTraces ? FMath::Min3(EnemiesTracedPerSpawn, NumEnemies, MaxEnemiesTraced) : 0;
+
+	Request.Scores.SetNumUninitialized(NumCandidates);
+	Request.TraceEnemyIndices.Init(INDEX_NONE, NumCandidates * NumTraced);
+
+	float* Scores = Request.Scores.GetData();
+	int32* TraceEnemyIndices = Request.TraceEnemyIndices.GetData();
+	const FVector* Candidates = CandidateLocations.GetData();
+	const FVector* Enemies = EnemyLocations.GetData();
+	const float IdealDistance = IdealEnemyDistance;
+
+	// Each candidate writes only its own score and its own NumTraced trace slots, sorted nearest first
+	auto ScoreCandidate = [=](int32 i)
+	{
+		int32* NearestEnemies = TraceEnemyIndices + i * NumTraced;
+		float NearestDistancesSquared[MaxEnemiesTraced];
+		int32 NumNearest = 0;
+		float MinDistanceSquared = FMath::Square(IdealDistance);
+
+		for (int32 EnemyIndex = 0; EnemyIndex < NumEnemies; EnemyIndex++)
+		{
+			const float DistanceSquared = FVector::DistSquared(Candidates[i], Enemies[EnemyIndex]);
+			MinDistanceSquared = FMath::Min(MinDistanceSquared, DistanceSquared);
+
+			if (NumNearest < NumTraced)
+			{
+				NumNearest++;
+			}
+			else if (NumTraced == 0 || DistanceSquared >= NearestDistancesSquared[NumTraced - 1])
+			{
+				continue;
+			}
+
+			int32 Slot = NumNearest - 1;
+			for (; Slot > 0 && NearestDistancesSquared[Slot - 1] > DistanceSquared; Slot--)
+			{
+				NearestDistancesSquared[Slot] = NearestDistancesSquared[Slot - 1];
+				NearestEnemies[Slot] = NearestEnemies[Slot - 1];
+			}
+
+			NearestDistancesSquared[Slot] = DistanceSquared;
+			NearestEnemies[Slot] = EnemyIndex;
+		}
+
+		Scores[i] = FMath::Sqrt(MinDistanceSquared) / IdealDistance;
+	};
+
+	ParallelFor(NumCandidates, ScoreCandidate, NumCandidates * NumEnemies < CVarSpawnParallelThreshold.GetValueOnGameThread());
+
+	if (Request.HasTracesToIssue())
+	{
+		SetActorTickEnabled(true);
+	}
+}
+
+void AGASShooterGameModeBase::IssueSpawnVisibilityTraces()
+{
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSSpawnScoring);
+
+	UWorld* World = GetWorld();
+	int32 TraceBudget = CVarSpawnTracesPerFrame.GetValueOnGameThread();
+	bool bHasTracesToIssue = false;
+
+	for (FGSSpawnScoringRequest& Request : SpawnScoringRequests)
+	{
+		FTraceDelegate TraceDelegate = FTraceDelegate::CreateUObject(this, &AGASShooterGameModeBase::OnSpawnVisibilityTraceDone, Request.RequestId);
+		const int32 NumTraced = Request.TraceEnemyIndices.Num() / FMath::Max(Request.Candidates.Num(), 1);
+
+		while (TraceBudget > 0 && Request.HasTracesToIssue())
+		{
+			const int32 Slot = Request.NextTrace++;
+			const int32 EnemyIndex = Request.TraceEnemyIndices[Slot];
+			AActor* Candidate = Request.Candidates[Slot / NumTraced].Get();
+			if (EnemyIndex == INDEX_NONE || !Candidate)
+			{
+				continue;
+			}
+
+			FCollisionQueryParams Params(SCENE_QUERY_STAT(GSSpawnVisibility), false);
+			Params.AddIgnoredActor(Candidate);
+			Params.AddIgnoredActor(Request.Enemies[EnemyIndex].Get());
+
+			// Trace to where the spawned hero's eyes would be
+			const FVector End = Candidate->GetActorLocation() + FVector(0.0f, 0.0f, 64.0f);
+			World->AsyncLineTraceByChannel(EAsyncTraceType::Single, Request.EnemyViewLocations[EnemyIndex], End, ECC_Visibility, Params,
+				FCollisionResponseParams::DefaultResponseParam, &TraceDelegate, Slot);
+
+			Request.NumTracesInFlight++;
+			TraceBudget--;
+		}
+
+		bHasTracesToIssue |= Request.HasTracesToIssue();
+	}
+
+	if (!bHasTracesToIssue)
+	{
+		SetActorTickEnabled(false);
+	}
+}
+
+void AGASShooterGameModeBase::OnSpawnVisibilityTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, int32 RequestId)
+{
+	// The hero may have respawned with the partial scores already
+	FGSSpawnScoringRequest* Request = SpawnScoringRequests.FindByPredicate([RequestId](const FGSSpawnScoringRequest& ScoringRequest) { return ScoringRequest.RequestId == RequestId; });
+	if (!Request)
+	{
+		return;
+	}
+
+	Request->NumTracesInFlight--;
+
+	if (!FHitResult::GetFirstBlockingHit(TraceDatum.OutHits))
+	{
+		const int32 NumTraced = Request->TraceEnemyIndices.Num() / Request->Candidates.Num();
+		Request->Scores[TraceDatum.UserData / NumTraced] -= VisibleSpawnPenalty;
+	}
+}
+
+AActor* AGASShooterGameModeBase::ChooseSpawnPoint(AController* Controller)
+{
+	int32 RequestIndex = SpawnScoringRequests.IndexOfByPredicate([Controller](const FGSSpawnScoringRequest& Request) { return Request.Controller == Controller; });
+	if (RequestIndex == INDEX_NONE)
+	{
+		// Not scored ahead of time, e.g. respawned without dying. Score by distance only since we can't wait for traces.
+		StartSpawnScoring(Controller, false);
+		RequestIndex = SpawnScoringRequests.Num() - 1;
+	}
+
+	const FGSSpawnScoringRequest& Request = SpawnScoringRequests[RequestIndex];
+	const float TimeSeconds = GetWorld()->GetTimeSeconds();
+
+	AActor* BestSpawnPoint = nullptr;
+	float BestScore = -MAX_FLT;
+
+	for (int32 i = 0; i < Request.Candidates.Num(); i++)
+	{
+		AActor* Candidate = Request.Candidates[i].Get();
+		if (!Candidate)
+		{
+			continue;
+		}
+
+		float Score = Request.Scores[i];
+
+		const float* LastUseTime = SpawnPointLastUseTimes.Find(Candidate);
+		if (LastUseTime && TimeSeconds - *LastUseTime < RecentSpawnTime)
+		{
+			Score -= RecentSpawnPenalty;
+		}
+
+		if (Score > BestScore)
+		{
+			BestScore = Score;
+			BestSpawnPoint = Candidate;
+		}
+	}
+
+	SpawnScoringRequests.RemoveAtSwap(RequestIndex);
+
+	if (BestSpawnPoint)
+	{
+		SpawnPointLastUseTimes.Add(BestSpawnPoint, TimeSeconds);
+	}
+
+	return BestSpawnPoint;
+}
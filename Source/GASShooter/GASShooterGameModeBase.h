@@ -6,6 +6,46 @@
 #include "GameFramework/GameModeBase.h"
 #include "GASShooterGameModeBase.generated.h"
 
+struct FTraceDatum;
+struct FTraceHandle;
+
+/**
+* Scores of every spawn point for one dead hero. Started when the hero dies so that the line of sight traces can be
+* spread over the frames of the respawn delay.
+*/
+struct FGSSpawnScoringRequest
+{
+	int32 RequestId;
+
+	TWeakObjectPtr<AController> Controller;
+
+	TArray<TWeakObjectPtr<AActor>> Candidates;
+
+	// Higher is better. Starts as the distance score and loses VisibleSpawnPenalty for every enemy that can see the candidate.
+	TArray<float> Scores;
+
+	TArray<TWeakObjectPtr<AActor>> Enemies;
+
+	TArray<FVector> EnemyViewLocations;
+
+	// The nearest enemies of each candidate to trace against, EnemiesTracedPerSpawn per candidate. INDEX_NONE if there are fewer enemies.
+	TArray<int32> TraceEnemyIndices;
+
+	// Next entry of TraceEnemyIndices to trace
+	int32 NextTrace;
+
+	int32 NumTracesInFlight;
+
+	FGSSpawnScoringRequest()
+		: RequestId(0), NextTrace(0), NumTracesInFlight(0)
+	{}
+
+	bool HasTracesToIssue() const
+	{
+		return NextTrace < TraceEnemyIndices.Num();
+	}
+};
+
 /**
  * 
  */
@@ -17,16 +57,59 @@ class GASSHOOTER_API AGASShooterGameModeBase : public AGameModeBase
 public:
 	AGASShooterGameModeBase();
 
+	virtual void Tick(float DeltaSeconds) override;
+
 	void HeroDied(AController* Controller);
 
 protected:
 	float RespawnDelay;
 
+	// Scoring starts this many seconds before the respawn so that the enemy positions aren't stale
+	float SpawnScoringLeadTime;
+
 	TSubclassOf<class AGSHeroCharacter> HeroClass;
 
-	AActor* EnemySpawnPoint;
+	// PlayerStarts with this PlayerStartTag or Actor tag are enemy spawns. The sample map's enemy spawn is an Actor with this name.
+	FName EnemySpawnTag;
+
+	// Enemies at least this far away from a spawn point give it the full distance score
+	float IdealEnemyDistance;
+
+	float VisibleSpawnPenalty;
+
+	// Penalty for a spawn point that was used less than RecentSpawnTime seconds ago so that heroes don't spawn on top of each other
+	float RecentSpawnPenalty;
+
+	float RecentSpawnTime;
+
+	int32 EnemiesTracedPerSpawn;
+
+	// Collected once in BeginPlay
+	TArray<TWeakObjectPtr<AActor>> PlayerSpawnPoints;
+
+	TArray<TWeakObjectPtr<AActor>> EnemySpawnPoints;
+
+	TMap<TWeakObjectPtr<AActor>, float> SpawnPointLastUseTimes;
+
+	TArray<FGSSpawnScoringRequest> SpawnScoringRequests;
+
+	int32 NextSpawnScoringRequestId;
 
 	virtual void BeginPlay() override;
 
 	void RespawnHero(AController* Controller);
+
+	void CollectSpawnPoints();
+
+	// Scores the candidates by distance to the enemies and, if bQueueTraces, queues the line of sight traces. Replaces any
+	// earlier request for Controller.
+	void StartSpawnScoring(AController* Controller, bool bQueueTraces = true);
+
+	// Issues up to GS.Spawn.TracesPerFrame line of sight traces across all requests
+	void IssueSpawnVisibilityTraces();
+
+	void OnSpawnVisibilityTraceDone(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum, int32 RequestId);
+
+	// Returns the best scored spawn point for Controller, even if some of its traces haven't finished. Null if there are no candidates.
+	AActor* ChooseSpawnPoint(AController* Controller);
 };
@@ -0,0 +1,15 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "GASShooterGameStateBase.h"
+#include "Items/Pickups/GSPickupStateComponent.h"
+
+AGASShooterGameStateBase::AGASShooterGameStateBase()
+{
+	PickupState = CreateDefaultSubobject<UGSPickupStateComponent>(FName("PickupState"));
+}
+
+UGSPickupStateComponent* AGASShooterGameStateBase::GetPickupState() const
+{
+	return PickupState;
+}
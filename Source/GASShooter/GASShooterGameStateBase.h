@@ -0,0 +1,28 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/GameStateBase.h"
+#include "GASShooterGameStateBase.generated.h"
+
+class UGSPickupStateComponent;
+
+/**
+ * 
+ */
+UCLASS()
+class GASSHOOTER_API AGASShooterGameStateBase : public AGameStateBase
+{
+	GENERATED_BODY()
+	
+public:
+	AGASShooterGameStateBase();
+
+	UGSPickupStateComponent* GetPickupState() const;
+
+protected:
+	// Replicates the active state of the level's pickups
+	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "GASShooter")
+	UGSPickupStateComponent* PickupState;
+};
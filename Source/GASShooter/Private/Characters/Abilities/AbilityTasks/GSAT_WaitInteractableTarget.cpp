@@ -3,15 +3,46 @@
 
 #include "Characters/Abilities/AbilityTasks/GSAT_WaitInteractableTarget.h"
 #include "Characters/Abilities/GSInteractable.h"
+#include "Characters/Abilities/GSInteractableSubsystem.h"
 #include "Characters/Heroes/GSHeroCharacter.h"
 #include "DrawDebugHelpers.h"
 #include "GSBlueprintFunctionLibrary.h"
 #include "TimerManager.h"
 
+static TAutoConsoleVariable<int32> CVarInteractionSpatialPrefilter(
+	TEXT("GS.Interaction.SpatialPrefilter"),
+	1,
+	TEXT("Skip interaction traces when no interactable Actor is within range. 0 always traces.")
+);
+
+static TAutoConsoleVariable<float> CVarInteractionReuseDistance(
+	TEXT("GS.Interaction.ReuseDistance"),
+	2.0f,
+	TEXT("Distance in cm the view or trace start can move before the last interaction trace is no longer reused")
+);
+
+static TAutoConsoleVariable<float> CVarInteractionReuseAngle(
+	TEXT("GS.Interaction.ReuseAngle"),
+	0.5f,
+	TEXT("Degrees the view can turn before the last interaction trace is no longer reused")
+);
+
+static TAutoConsoleVariable<float> CVarInteractionReuseMaxAge(
+	TEXT("GS.Interaction.ReuseMaxAge"),
+	0.5f,
+	TEXT("Seconds the last interaction trace can be reused for while standing still. 0 disables reuse.")
+);
+
 UGSAT_WaitInteractableTarget::UGSAT_WaitInteractableTarget(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
 {
 	bTraceAffectsAimPitch = true;
+	LastTraceViewLocation = FVector::ZeroVector;
+	LastTraceViewDirection = FVector::ZeroVector;
+	LastTraceStart = FVector::ZeroVector;
+	LastTraceTime = 0.0f;
+	LastTraceAvailabilityVersion = 0;
+	bHasLastTrace = false;
 }
 
 UGSAT_WaitInteractableTarget* UGSAT_WaitInteractableTarget::WaitForInteractableTarget(UGameplayAbility* OwningAbility, FName TaskInstanceName, FCollisionProfileName TraceProfile, float MaxRange, float TimerPeriod, bool bShowDebug)
@@ -110,17 +141,10 @@ void UGSAT_WaitInteractableTarget::AimWithPlayerController(const AActor* InSourc
 		return;
 	}
 
-	APlayerController* PC = Ability->GetCurrentActorInfo()->PlayerController.Get();
-
-	// Default to TraceStart if no PlayerController
-	FVector ViewStart = TraceStart;
-	FRotator ViewRot(0.0f);
-	if (PC)
-	{
-		PC->GetPlayerViewPoint(ViewStart, ViewRot);
-	}
+	FVector ViewStart;
+	FVector ViewDir;
+	GetViewPoint(TraceStart, ViewStart, ViewDir);
 
-	const FVector ViewDir = ViewRot.Vector();
 	FVector ViewEnd = ViewStart + (ViewDir * MaxRange);
 
 	ClipCameraRayToAbilityRange(ViewStart, ViewDir, TraceStart, MaxRange, ViewEnd);
@@ -176,6 +200,50 @@ bool UGSAT_WaitInteractableTarget::ClipCameraRayToAbilityRange(FVector CameraLoc
 	return false;
 }
 
+void UGSAT_WaitInteractableTarget::GetViewPoint(const FVector& TraceStart, FVector& OutViewLocation, FVector& OutViewDirection) const
+{
+	APlayerController* PC = Ability ? Ability->GetCurrentActorInfo()->PlayerController.Get() : nullptr;
+
+	// Default to TraceStart if no PlayerController
+	OutViewLocation = TraceStart;
+	FRotator ViewRot(0.0f);
+	if (PC)
+	{
+		PC->GetPlayerViewPoint(OutViewLocation, ViewRot);
+	}
+
+	OutViewDirection = ViewRot.Vector();
+}
+
+bool UGSAT_WaitInteractableTarget::CanReuseLastTrace(const FVector& ViewLocation, const FVector& ViewDirection, const FVector& TraceStart) const
+{
+	const float MaxAge = CVarInteractionReuseMaxAge.GetValueOnGameThread();
+	if (!bHasLastTrace || MaxAge <= 0.0f || GetWorld()->GetTimeSeconds() - LastTraceTime > MaxAge)
+	{
+		return false;
+	}
+
+	// Our last target may have been destroyed since then
+	if (TargetData.Num() > 0 && TargetData.Get(0)->GetHitResult()->Actor.IsStale())
+	{
+		return false;
+	}
+
+	// Or something in range may have become available or unavailable
+	const UGSInteractableSubsystem* InteractableSubsystem = GetWorld()->GetSubsystem<UGSInteractableSubsystem>();
+	if (InteractableSubsystem && InteractableSubsystem->GetAvailabilityVersion() != LastTraceAvailabilityVersion)
+	{
+		return false;
+	}
+
+	const float MaxDistanceSquared = FMath::Square(CVarInteractionReuseDistance.GetValueOnGameThread());
+	const float MinDot = FMath::Cos(FMath::DegreesToRadians(CVarInteractionReuseAngle.GetValueOnGameThread()));
+
+	return FVector::DistSquared(ViewLocation, LastTraceViewLocation) <= MaxDistanceSquared
+		&& FVector::DistSquared(TraceStart, LastTraceStart) <= MaxDistanceSquared
+		&& FVector::DotProduct(ViewDirection, LastTraceViewDirection) >= MinDot;
+}
+
 void UGSAT_WaitInteractableTarget::PerformTrace()
 {
 	bool bTraceComplex = false;
@@ -206,8 +274,50 @@ void UGSAT_WaitInteractableTarget::PerformTrace()
 	Params.bReturnPhysicalMaterial = true;
 	Params.AddIgnoredActors(ActorsToIgnore);
 
-	// Calculate TraceEnd
 	FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
+
+	FVector ViewLocation;
+	FVector ViewDirection;
+	GetViewPoint(TraceStart, ViewLocation, ViewDirection);
+
+	// Nothing to interact with within range, don't bother tracing
+	UGSInteractableSubsystem* InteractableSubsystem = GetWorld()->GetSubsystem<UGSInteractableSubsystem>();
+	if (CVarInteractionSpatialPrefilter.GetValueOnGameThread() > 0 && InteractableSubsystem
+		&& !InteractableSubsystem->HasInteractableInRange(TraceStart, MaxRange, SourceActor))
+	{
+		bHasLastTrace = false;
+
+		FHitResult ReturnHitResult;
+		ReturnHitResult.TraceStart = TraceStart;
+		ReturnHitResult.TraceEnd = TraceStart + (ViewDirection * MaxRange);
+		ReturnHitResult.Location = ReturnHitResult.TraceEnd;
+
+		if (TargetData.Num() > 0 && TargetData.Get(0)->GetHitResult()->Actor.Get())
+		{
+			// Previous trace had a valid Interactable Actor, now we don't have one
+			// Broadcast last valid target
+			LostInteractableTarget.Broadcast(TargetData);
+			TargetData = MakeTargetData(ReturnHitResult);
+		}
+
+		ShowDebugTrace(TraceStart, ReturnHitResult.TraceEnd, ReturnHitResult);
+		return;
+	}
+
+	// We haven't moved or turned since the last trace, it still has the same result
+	if (CanReuseLastTrace(ViewLocation, ViewDirection, TraceStart))
+	{
+		return;
+	}
+
+	bHasLastTrace = true;
+	LastTraceViewLocation = ViewLocation;
+	LastTraceViewDirection = ViewDirection;
+	LastTraceStart = TraceStart;
+	LastTraceTime = GetWorld()->GetTimeSeconds();
+	LastTraceAvailabilityVersion = InteractableSubsystem ? InteractableSubsystem->GetAvailabilityVersion() : 0;
+
+	// Calculate TraceEnd
 	FVector TraceEnd;
 	AimWithPlayerController(SourceActor, Params, TraceStart, TraceEnd); //Effective on server and launching client only
 
@@ -263,18 +373,23 @@ void UGSAT_WaitInteractableTarget::PerformTrace()
 		}
 	}
 
+	ShowDebugTrace(TraceStart, TraceEnd, ReturnHitResult);
+}
+
+void UGSAT_WaitInteractableTarget::ShowDebugTrace(const FVector& TraceStart, const FVector& TraceEnd, const FHitResult& HitResult) const
+{
 #if ENABLE_DRAW_DEBUG
 	if (bShowDebug)
 	{
 		DrawDebugLine(GetWorld(), TraceStart, TraceEnd, FColor::Green, false, TimerPeriod);
 		
-		if (ReturnHitResult.bBlockingHit)
+		if (HitResult.bBlockingHit)
 		{
-			DrawDebugSphere(GetWorld(), ReturnHitResult.Location, 20.0f, 16, FColor::Red, false, TimerPeriod);
+			DrawDebugSphere(GetWorld(), HitResult.Location, 20.0f, 16, FColor::Red, false, TimerPeriod);
 		}
 		else
 		{
-			DrawDebugSphere(GetWorld(), ReturnHitResult.TraceEnd, 20.0f, 16, FColor::Green, false, TimerPeriod);
+			DrawDebugSphere(GetWorld(), HitResult.TraceEnd, 20.0f, 16, FColor::Green, false, TimerPeriod);
 		}
 	}
 #endif // ENABLE_DRAW_DEBUG
@@ -4,6 +4,8 @@
 #include "Characters/Abilities/AbilityTasks/GSAT_WaitTargetDataUsingActor.h"
 #include "AbilitySystemComponent.h"
 #include "Characters/Abilities/GSGATA_Trace.h"
+#include "Characters/Abilities/GSLagCompensationSubsystem.h"
+#include "GameFramework/PlayerState.h"
 
 UGSAT_WaitTargetDataUsingActor::UGSAT_WaitTargetDataUsingActor(const FObjectInitializer& ObjectInitializer)
 	: Super(ObjectInitializer)
@@ -45,6 +47,14 @@ void UGSAT_WaitTargetDataUsingActor::OnTargetDataReplicatedCallback(const FGamep
 	FGameplayAbilityTargetDataHandle MutableData = Data;
 	AbilitySystemComponent->ConsumeClientReplicatedTargetData(GetAbilitySpecHandle(), GetActivationPredictionKey());
 
+	// Drop any hits that don't match where the target was on the client's screen when they fired
+	UGSLagCompensationSubsystem* LagCompensation = GetWorld() ? GetWorld()->GetSubsystem<UGSLagCompensationSubsystem>() : nullptr;
+	if (LagCompensation && Ability)
+	{
+		const APlayerState* ShooterPlayerState = Cast<APlayerState>(Ability->GetCurrentActorInfo()->OwnerActor.Get());
+		LagCompensation->ValidateTargetData(Data, ShooterPlayerState, MutableData);
+	}
+
 	/**
 	 *  Call into the TargetActor to sanitize/verify the data. If this returns false, we are rejecting
 	 *	the replicated target data and will treat this as a cancel.
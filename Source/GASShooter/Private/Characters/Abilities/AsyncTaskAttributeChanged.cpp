@@ -41,6 +41,14 @@ UAsyncTaskAttributeChanged * UAsyncTaskAttributeChanged::ListenForAttributesChan
 }
 
 void UAsyncTaskAttributeChanged::EndTask()
+{
+	StopListening();
+
+	SetReadyToDestroy();
+	MarkPendingKill();
+}
+
+void UAsyncTaskAttributeChanged::StopListening()
 {
 	if (IsValid(ASC))
 	{
@@ -52,8 +60,7 @@ void UAsyncTaskAttributeChanged::EndTask()
 		}
 	}
 
-	SetReadyToDestroy();
-	MarkPendingKill();
+	OnAttributeChanged.Clear();
 }
 
 void UAsyncTaskAttributeChanged::AttributeChanged(const FOnAttributeChangeData & Data)
@@ -6,6 +6,8 @@
 #include "GameplayEffectExtension.h"
 #include "Net/UnrealNetwork.h"
 
+UGSAmmoAttributeSet::FAmmoTypeRegistry UGSAmmoAttributeSet::AmmoTypeRegistry;
+
 UGSAmmoAttributeSet::UGSAmmoAttributeSet()
 {
 	RifleAmmoTag = FGameplayTag::RequestGameplayTag(FName("Weapon.Ammo.Rifle"));
@@ -13,6 +15,27 @@ UGSAmmoAttributeSet::UGSAmmoAttributeSet()
 	ShotgunAmmoTag = FGameplayTag::RequestGameplayTag(FName("Weapon.Ammo.Shotgun"));
 }
 
+void UGSAmmoAttributeSet::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	// A new CDO, e.g. after a hot reload, may have different ammo types
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		AmmoTypeRegistry.bBuilt = false;
+	}
+}
+
+void UGSAmmoAttributeSet::PostReloadConfig(FProperty* PropertyThatWasLoaded)
+{
+	Super::PostReloadConfig(PropertyThatWasLoaded);
+
+	if (HasAnyFlags(RF_ClassDefaultObject))
+	{
+		AmmoTypeRegistry.bBuilt = false;
+	}
+}
+
 void UGSAmmoAttributeSet::PreAttributeChange(const FGameplayAttribute& Attribute, float& NewValue)
 {
 	Super::PreAttributeChange(Attribute, NewValue);
@@ -22,20 +45,11 @@ void UGSAmmoAttributeSet::PostGameplayEffectExecute(const FGameplayEffectModCall
 {
 	Super::PostGameplayEffectExecute(Data);
 
-	if (Data.EvaluatedData.Attribute == GetRifleReserveAmmoAttribute())
-	{
-		float Ammo = GetRifleReserveAmmo();
-		SetRifleReserveAmmo(FMath::Clamp<float>(Ammo, 0, GetMaxRifleReserveAmmo()));
-	}
-	else if (Data.EvaluatedData.Attribute == GetRocketReserveAmmoAttribute())
-	{
-		float Ammo = GetRocketReserveAmmo();
-		SetRocketReserveAmmo(FMath::Clamp<float>(Ammo, 0, GetMaxRocketReserveAmmo()));
-	}
-	else if (Data.EvaluatedData.Attribute == GetShotgunReserveAmmoAttribute())
+	const FGSAmmoTypeAttributes* AmmoType = FindAmmoTypeByReserveAttribute(Data.EvaluatedData.Attribute);
+	UAbilitySystemComponent* AbilityComp = GetOwningAbilitySystemComponent();
+	if (AmmoType && AbilityComp)
 	{
-		float Ammo = GetShotgunReserveAmmo();
-		SetShotgunReserveAmmo(FMath::Clamp<float>(Ammo, 0, GetMaxShotgunReserveAmmo()));
+		ClampReserveAmmo(AbilityComp, *AmmoType);
 	}
 }
 
@@ -51,40 +65,94 @@ void UGSAmmoAttributeSet::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 	DOREPLIFETIME_CONDITION_NOTIFY(UGSAmmoAttributeSet, MaxShotgunReserveAmmo, COND_None, REPNOTIFY_Always);
 }
 
-FGameplayAttribute UGSAmmoAttributeSet::GetReserveAmmoAttributeFromTag(FGameplayTag& PrimaryAmmoTag)
+FGameplayAttribute UGSAmmoAttributeSet::GetReserveAmmoAttributeFromTag(const FGameplayTag& PrimaryAmmoTag)
 {
-	if (PrimaryAmmoTag == FGameplayTag::RequestGameplayTag(FName("Weapon.Ammo.Rifle")))
+	const FGSAmmoTypeAttributes* AmmoType = FindAmmoType(PrimaryAmmoTag);
+	return AmmoType ? AmmoType->ReserveAmmoAttribute : FGameplayAttribute();
+}
+
+FGameplayAttribute UGSAmmoAttributeSet::GetMaxReserveAmmoAttributeFromTag(const FGameplayTag& PrimaryAmmoTag)
+{
+	const FGSAmmoTypeAttributes* AmmoType = FindAmmoType(PrimaryAmmoTag);
+	return AmmoType ? AmmoType->MaxReserveAmmoAttribute : FGameplayAttribute();
+}
+
+const FGSAmmoTypeAttributes* UGSAmmoAttributeSet::FindAmmoType(const FGameplayTag& AmmoTag)
+{
+	const FAmmoTypeRegistry& Registry = GetAmmoTypeRegistry();
+	const int32* AmmoTypeIndex = Registry.AmmoTypeIndexByTag.Find(AmmoTag);
+	return AmmoTypeIndex ? &Registry.AmmoTypes[*AmmoTypeIndex] : nullptr;
+}
+
+const FGSAmmoTypeAttributes* UGSAmmoAttributeSet::FindAmmoTypeByReserveAttribute(const FGameplayAttribute& ReserveAmmoAttribute)
+{
+	const FAmmoTypeRegistry& Registry = GetAmmoTypeRegistry();
+	const int32* AmmoTypeIndex = Registry.AmmoTypeIndexByReserveAttribute.Find(ReserveAmmoAttribute);
+	return AmmoTypeIndex ? &Registry.AmmoTypes[*AmmoTypeIndex] : nullptr;
+}
+
+const TArray<FGSAmmoTypeAttributes>& UGSAmmoAttributeSet::GetAmmoTypes()
+{
+	return GetAmmoTypeRegistry().AmmoTypes;
+}
+
+void UGSAmmoAttributeSet::ClampReserveAmmo(UAbilitySystemComponent* AbilityComp, const FGSAmmoTypeAttributes& AmmoType)
+{
+	const float Ammo = AbilityComp->GetNumericAttribute(AmmoType.ReserveAmmoAttribute);
+	const float MaxAmmo = AbilityComp->GetNumericAttribute(AmmoType.MaxReserveAmmoAttribute);
+	if (Ammo < 0.0f || Ammo > MaxAmmo)
 	{
-		return GetRifleReserveAmmoAttribute();
+		AbilityComp->SetNumericAttributeBase(AmmoType.ReserveAmmoAttribute, FMath::Clamp<float>(Ammo, 0, MaxAmmo));
 	}
-	else if (PrimaryAmmoTag == FGameplayTag::RequestGameplayTag(FName("Weapon.Ammo.Rocket")))
+}
+
+void UGSAmmoAttributeSet::RebuildAmmoTypes()
+{
+	AmmoTypeRegistry = FAmmoTypeRegistry();
+	AmmoTypeRegistry.bBuilt = true;
+
+	const UGSAmmoAttributeSet* AmmoAttributeSetCDO = GetDefault<UGSAmmoAttributeSet>();
+	AmmoAttributeSetCDO->RegisterAmmoType(AmmoTypeRegistry, AmmoAttributeSetCDO->RifleAmmoTag, GetRifleReserveAmmoAttribute(), GetMaxRifleReserveAmmoAttribute());
+	AmmoAttributeSetCDO->RegisterAmmoType(AmmoTypeRegistry, AmmoAttributeSetCDO->RocketAmmoTag, GetRocketReserveAmmoAttribute(), GetMaxRocketReserveAmmoAttribute());
+	AmmoAttributeSetCDO->RegisterAmmoType(AmmoTypeRegistry, AmmoAttributeSetCDO->ShotgunAmmoTag, GetShotgunReserveAmmoAttribute(), GetMaxShotgunReserveAmmoAttribute());
+
+	for (const FGSAmmoTypeAttributes& AmmoType : AmmoAttributeSetCDO->AdditionalAmmoTypes)
 	{
-		return GetRocketReserveAmmoAttribute();
+		AmmoAttributeSetCDO->RegisterAmmoType(AmmoTypeRegistry, AmmoType.AmmoTag, AmmoType.ReserveAmmoAttribute, AmmoType.MaxReserveAmmoAttribute);
 	}
-	else if (PrimaryAmmoTag == FGameplayTag::RequestGameplayTag(FName("Weapon.Ammo.Shotgun")))
+}
+
+const UGSAmmoAttributeSet::FAmmoTypeRegistry& UGSAmmoAttributeSet::GetAmmoTypeRegistry()
+{
+	if (!AmmoTypeRegistry.bBuilt)
 	{
-		return GetShotgunReserveAmmoAttribute();
+		RebuildAmmoTypes();
 	}
 
-	return FGameplayAttribute();
+	return AmmoTypeRegistry;
 }
 
-FGameplayAttribute UGSAmmoAttributeSet::GetMaxReserveAmmoAttributeFromTag(FGameplayTag& PrimaryAmmoTag)
+void UGSAmmoAttributeSet::RegisterAmmoType(FAmmoTypeRegistry& Registry, const FGameplayTag& AmmoTag, const FGameplayAttribute& ReserveAmmoAttribute, const FGameplayAttribute& MaxReserveAmmoAttribute) const
 {
-	if (PrimaryAmmoTag == FGameplayTag::RequestGameplayTag(FName("Weapon.Ammo.Rifle")))
-	{
-		return GetMaxRifleReserveAmmoAttribute();
-	}
-	else if (PrimaryAmmoTag == FGameplayTag::RequestGameplayTag(FName("Weapon.Ammo.Rocket")))
+	if (!AmmoTag.IsValid() || !ReserveAmmoAttribute.IsValid() || !MaxReserveAmmoAttribute.IsValid())
 	{
-		return GetMaxRocketReserveAmmoAttribute();
+		UE_LOG(LogTemp, Error, TEXT("%s Invalid ammo type %s"), *FString(__FUNCTION__), *AmmoTag.ToString());
+		return;
 	}
-	else if (PrimaryAmmoTag == FGameplayTag::RequestGameplayTag(FName("Weapon.Ammo.Shotgun")))
+
+	if (Registry.AmmoTypeIndexByTag.Contains(AmmoTag))
 	{
-		return GetMaxShotgunReserveAmmoAttribute();
+		UE_LOG(LogTemp, Warning, TEXT("%s Ammo type %s is already registered"), *FString(__FUNCTION__), *AmmoTag.ToString());
+		return;
 	}
 
-	return FGameplayAttribute();
+	FGSAmmoTypeAttributes& AmmoType = Registry.AmmoTypes.AddDefaulted_GetRef();
+	AmmoType.AmmoTag = AmmoTag;
+	AmmoType.ReserveAmmoAttribute = ReserveAmmoAttribute;
+	AmmoType.MaxReserveAmmoAttribute = MaxReserveAmmoAttribute;
+
+	Registry.AmmoTypeIndexByTag.Add(AmmoTag, Registry.AmmoTypes.Num() - 1);
+	Registry.AmmoTypeIndexByReserveAttribute.Add(ReserveAmmoAttribute, Registry.AmmoTypes.Num() - 1);
 }
 
 void UGSAmmoAttributeSet::AdjustAttributeForMaxChange(FGameplayAttributeData& AffectedAttribute, const FGameplayAttributeData& MaxAttribute, float NewMaxValue, const FGameplayAttribute& AffectedAttributeProperty)
@@ -2,12 +2,74 @@
 
 
 #include "Characters/Abilities/AttributeSets/GSAttributeSetBase.h"
+#include "Characters/Abilities/GSAbilitySystemComponent.h"
+#include "Characters/Abilities/GSAbilitySystemGlobals.h"
+#include "Characters/Abilities/GSGE_Bounty.h"
 #include "Characters/GSCharacterBase.h"
 #include "GameplayEffect.h"
 #include "GameplayEffectExtension.h"
+#include "GSStats.h"
 #include "Net/UnrealNetwork.h"
 #include "Player/GSPlayerController.h"
 
+#if !UE_BUILD_SHIPPING
+namespace GSAttributeReplicationStats
+{
+	// Counts the replicated attribute updates this client receives through the OnRep functions. Bytes are only estimated
+	// from the counts, use the Network Profiler (netprofile) on the Server for the bits each property really costs.
+	struct FAttributeReplicationCount
+	{
+		int32 NumOwnerUpdates = 0;
+		int32 NumSimulatedUpdates = 0;
+	};
+
+	// BaseValue and CurrentValue of an FGameplayAttributeData. Excludes property handles and packet overhead.
+	static constexpr int32 EstimatedBytesPerUpdate = sizeof(float) * 2;
+
+	static TMap<FString, FAttributeReplicationCount> CountsByAttribute;
+	static double StartTime = 0.0;
+
+	static void Reset()
+	{
+		CountsByAttribute.Reset();
+		StartTime = FPlatformTime::Seconds();
+	}
+
+	static void Report()
+	{
+		const double Minutes = FMath::Max((FPlatformTime::Seconds() - StartTime) / 60.0, 1.0 / 60.0);
+
+		UE_LOG(LogTemp, Log, TEXT("%s Attribute updates received over %.2f minutes"), *FString(__FUNCTION__), Minutes);
+
+		int32 TotalUpdates = 0;
+		for (const TPair<FString, FAttributeReplicationCount>& Pair : CountsByAttribute)
+		{
+			TotalUpdates += Pair.Value.NumOwnerUpdates + Pair.Value.NumSimulatedUpdates;
+
+			UE_LOG(LogTemp, Log, TEXT("%s %s Owner: %.1f updates/min (~%.0f estimated bytes/min) Simulated: %.1f updates/min (~%.0f estimated bytes/min)"),
+				*FString(__FUNCTION__), *Pair.Key,
+				Pair.Value.NumOwnerUpdates / Minutes, Pair.Value.NumOwnerUpdates * EstimatedBytesPerUpdate / Minutes,
+				Pair.Value.NumSimulatedUpdates / Minutes, Pair.Value.NumSimulatedUpdates * EstimatedBytesPerUpdate / Minutes);
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("%s Total: %.1f updates/min (~%.0f estimated bytes/min)"), *FString(__FUNCTION__), TotalUpdates / Minutes,
+			TotalUpdates * EstimatedBytesPerUpdate / Minutes);
+	}
+}
+
+static FAutoConsoleCommand ReportAttributeReplicationCommand(
+	TEXT("GS.Attributes.ReplicationReport"),
+	TEXT("Logs how many replicated updates per minute this client has received for each UGSAttributeSetBase attribute, split by our own and simulated heroes, with bytes estimated from the counts. Use netprofile for real bits."),
+	FConsoleCommandDelegate::CreateStatic(&GSAttributeReplicationStats::Report)
+);
+
+static FAutoConsoleCommand ResetAttributeReplicationCommand(
+	TEXT("GS.Attributes.ReplicationReset"),
+	TEXT("Clears the counts used by GS.Attributes.ReplicationReport"),
+	FConsoleCommandDelegate::CreateStatic(&GSAttributeReplicationStats::Reset)
+);
+#endif
+
 UGSAttributeSetBase::UGSAttributeSetBase()
 {
 	// Cache tags
@@ -41,6 +103,8 @@ void UGSAttributeSetBase::PreAttributeChange(const FGameplayAttribute& Attribute
 
 void UGSAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data)
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSAttributePostExecute);
+
 	Super::PostGameplayEffectExecute(Data);
 
 	FGameplayEffectContextHandle Context = Data.EffectSpec.GetContext();
@@ -159,24 +223,15 @@ void UGSAttributeSetBase::PostGameplayEffectExecute(const FGameplayEffectModCall
 					// Don't give bounty to self.
 					if (SourceController != TargetController)
 					{
-						// Create a dynamic instant Gameplay Effect to give the bounties
-						UGameplayEffect* GEBounty = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("Bounty")));
-						GEBounty->DurationPolicy = EGameplayEffectDurationType::Instant;
-
-						int32 Idx = GEBounty->Modifiers.Num();
-						GEBounty->Modifiers.SetNum(Idx + 2);
-
-						FGameplayModifierInfo& InfoXP = GEBounty->Modifiers[Idx];
-						InfoXP.ModifierMagnitude = FScalableFloat(GetXPBounty());
-						InfoXP.ModifierOp = EGameplayModOp::Additive;
-						InfoXP.Attribute = UGSAttributeSetBase::GetXPAttribute();
-
-						FGameplayModifierInfo& InfoGold = GEBounty->Modifiers[Idx + 1];
-						InfoGold.ModifierMagnitude = FScalableFloat(GetGoldBounty());
-						InfoGold.ModifierOp = EGameplayModOp::Additive;
-						InfoGold.Attribute = UGSAttributeSetBase::GetGoldAttribute();
-
-						Source->ApplyGameplayEffectToSelf(GEBounty, 1.0f, Source->MakeEffectContext());
+						// Give the bounties with the prebuilt bounty Gameplay Effect
+						UGSAbilitySystemComponent* GSSource = Cast<UGSAbilitySystemComponent>(Source);
+						FGameplayEffectSpec* BountySpec = GSSource ? GSSource->GetReusableOutgoingSpec(UGSAbilitySystemGlobals::GSGet().BountyEffect) : nullptr;
+						if (BountySpec)
+						{
+							BountySpec->SetSetByCallerMagnitude(UGSAbilitySystemGlobals::GSGet().XPBountyTag, GetXPBounty());
+							BountySpec->SetSetByCallerMagnitude(UGSAbilitySystemGlobals::GSGet().GoldBountyTag, GetGoldBounty());
+							GSSource->ApplyGameplayEffectSpecToSelf(*BountySpec);
+						}
 					}
 				}
 			}
@@ -209,25 +264,30 @@ void UGSAttributeSetBase::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>&
 {
 	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
 
+	// Needed by everyone for floating status bars, movement and level display
 	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, Health, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, MaxHealth, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, HealthRegenRate, COND_None, REPNOTIFY_Always);
 	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, Mana, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, MaxMana, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, ManaRegenRate, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, Stamina, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, MaxStamina, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, StaminaRegenRate, COND_None, REPNOTIFY_Always);
 	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, Shield, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, MaxShield, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, ShieldRegenRate, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, Armor, COND_None, REPNOTIFY_Always);
 	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, MoveSpeed, COND_None, REPNOTIFY_Always);
+
+	// Maxima that everyone needs. These only change on level up or with buffs.
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, MaxHealth, COND_None, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, MaxMana, COND_None, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, MaxShield, COND_None, REPNOTIFY_Always);
 	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, CharacterLevel, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, XP, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, XPBounty, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, Gold, COND_None, REPNOTIFY_Always);
-	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, GoldBounty, COND_None, REPNOTIFY_Always);
+
+	// Only the owner's HUD and predicted abilities use these. The Server does all of the regen and bounty math.
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, Stamina, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, MaxStamina, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, Armor, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, HealthRegenRate, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, ManaRegenRate, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, StaminaRegenRate, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, ShieldRegenRate, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, XP, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, XPBounty, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, Gold, COND_OwnerOnly, REPNOTIFY_Always);
+	DOREPLIFETIME_CONDITION_NOTIFY(UGSAttributeSetBase, GoldBounty, COND_OwnerOnly, REPNOTIFY_Always);
 }
 
 void UGSAttributeSetBase::AdjustAttributeForMaxChange(FGameplayAttributeData& AffectedAttribute, const FGameplayAttributeData& MaxAttribute, float NewMaxValue, const FGameplayAttribute& AffectedAttributeProperty)
@@ -244,97 +304,138 @@ void UGSAttributeSetBase::AdjustAttributeForMaxChange(FGameplayAttributeData& Af
 	}
 }
 
+void UGSAttributeSetBase::RecordReplicatedAttribute(const FGameplayAttribute& Attribute)
+{
+#if !UE_BUILD_SHIPPING
+	if (GSAttributeReplicationStats::StartTime == 0.0)
+	{
+		GSAttributeReplicationStats::Reset();
+	}
+
+	GSAttributeReplicationStats::FAttributeReplicationCount& Count = GSAttributeReplicationStats::CountsByAttribute.FindOrAdd(Attribute.GetName());
+
+	const UAbilitySystemComponent* ASC = GetOwningAbilitySystemComponent();
+	if (ASC && ASC->AbilityActorInfo.IsValid() && ASC->AbilityActorInfo->IsLocallyControlled())
+	{
+		Count.NumOwnerUpdates++;
+	}
+	else
+	{
+		Count.NumSimulatedUpdates++;
+	}
+#endif
+}
+
 void UGSAttributeSetBase::OnRep_Health(const FGameplayAttributeData& OldHealth)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, Health, OldHealth);
+	RecordReplicatedAttribute(GetHealthAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_MaxHealth(const FGameplayAttributeData& OldMaxHealth)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, MaxHealth, OldMaxHealth);
+	RecordReplicatedAttribute(GetMaxHealthAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_HealthRegenRate(const FGameplayAttributeData& OldHealthRegenRate)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, HealthRegenRate, OldHealthRegenRate);
+	RecordReplicatedAttribute(GetHealthRegenRateAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_Mana(const FGameplayAttributeData& OldMana)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, Mana, OldMana);
+	RecordReplicatedAttribute(GetManaAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_MaxMana(const FGameplayAttributeData& OldMaxMana)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, MaxMana, OldMaxMana);
+	RecordReplicatedAttribute(GetMaxManaAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_ManaRegenRate(const FGameplayAttributeData& OldManaRegenRate)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, ManaRegenRate, OldManaRegenRate);
+	RecordReplicatedAttribute(GetManaRegenRateAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_Stamina(const FGameplayAttributeData& OldStamina)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, Stamina, OldStamina);
+	RecordReplicatedAttribute(GetStaminaAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_MaxStamina(const FGameplayAttributeData& OldMaxStamina)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, MaxStamina, OldMaxStamina);
+	RecordReplicatedAttribute(GetMaxStaminaAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_StaminaRegenRate(const FGameplayAttributeData& OldStaminaRegenRate)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, StaminaRegenRate, OldStaminaRegenRate);
+	RecordReplicatedAttribute(GetStaminaRegenRateAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_Shield(const FGameplayAttributeData& OldShield)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, Shield, OldShield);
+	RecordReplicatedAttribute(GetShieldAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_MaxShield(const FGameplayAttributeData& OldMaxShield)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, MaxShield, OldMaxShield);
+	RecordReplicatedAttribute(GetMaxShieldAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_ShieldRegenRate(const FGameplayAttributeData& OldShieldRegenRate)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, ShieldRegenRate, OldShieldRegenRate);
+	RecordReplicatedAttribute(GetShieldRegenRateAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_Armor(const FGameplayAttributeData& OldArmor)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, Armor, OldArmor);
+	RecordReplicatedAttribute(GetArmorAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_MoveSpeed(const FGameplayAttributeData& OldMoveSpeed)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, MoveSpeed, OldMoveSpeed);
+	RecordReplicatedAttribute(GetMoveSpeedAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_CharacterLevel(const FGameplayAttributeData& OldCharacterLevel)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, CharacterLevel, OldCharacterLevel);
+	RecordReplicatedAttribute(GetCharacterLevelAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_XP(const FGameplayAttributeData& OldXP)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, XP, OldXP);
+	RecordReplicatedAttribute(GetXPAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_XPBounty(const FGameplayAttributeData& OldXPBounty)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, XPBounty, OldXPBounty);
+	RecordReplicatedAttribute(GetXPBountyAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_Gold(const FGameplayAttributeData& OldGold)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, Gold, OldGold);
+	RecordReplicatedAttribute(GetGoldAttribute());
 }
 
 void UGSAttributeSetBase::OnRep_GoldBounty(const FGameplayAttributeData& OldGoldBounty)
 {
 	GAMEPLAYATTRIBUTE_REPNOTIFY(UGSAttributeSetBase, GoldBounty, OldGoldBounty);
+	RecordReplicatedAttribute(GetGoldBountyAttribute());
 }
@@ -4,9 +4,11 @@
 #include "Characters/Abilities/GSAbilitySystemComponent.h"
 #include "AbilitySystemGlobals.h"
 #include "Animation/AnimInstance.h"
+#include "Characters/Abilities/AttributeSets/GSAmmoAttributeSet.h"
 #include "Characters/Abilities/GSGameplayAbility.h"
 #include "GameplayCueManager.h"
 #include "GSBlueprintFunctionLibrary.h"
+#include "GSStats.h"
 #include "Net/UnrealNetwork.h"
 #include "Weapons/GSWeapon.h"
 
@@ -16,8 +18,27 @@ static TAutoConsoleVariable<float> CVarReplayMontageErrorThreshold(
 	TEXT("Tolerance level for when montage playback position correction occurs in replays")
 );
 
+void FGameplayAbilityRepAnimMontageForMesh::PostReplicatedAdd(const FGameplayAbilityRepAnimMontageForMeshArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnRep_ReplicatedAnimMontageForMesh(*this);
+	}
+}
+
+void FGameplayAbilityRepAnimMontageForMesh::PostReplicatedChange(const FGameplayAbilityRepAnimMontageForMeshArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnRep_ReplicatedAnimMontageForMesh(*this);
+	}
+}
+
 UGSAbilitySystemComponent::UGSAbilitySystemComponent()
 {
+	bAbilitySpecIndexDirty = false;
+	bReserveAmmoClampsBound = false;
+	RepAnimMontageInfoForMeshes.Owner = this;
 }
 
 void UGSAbilitySystemComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
@@ -29,7 +50,7 @@ void UGSAbilitySystemComponent::GetLifetimeReplicatedProps(TArray<FLifetimePrope
 
 bool UGSAbilitySystemComponent::GetShouldTick() const
 {
-	for (FGameplayAbilityRepAnimMontageForMesh RepMontageInfo : RepAnimMontageInfoForMeshes)
+	for (const FGameplayAbilityRepAnimMontageForMesh& RepMontageInfo : RepAnimMontageInfoForMeshes.Items)
 	{
 		const bool bHasReplicatedMontageInfoToUpdate = (IsOwnerActorAuthoritative() && RepMontageInfo.RepMontageInfo.IsStopped == false);
 
@@ -60,7 +81,18 @@ void UGSAbilitySystemComponent::InitAbilityActorInfo(AActor* InOwnerActor, AActo
 	Super::InitAbilityActorInfo(InOwnerActor, InAvatarActor);
 
 	LocalAnimMontageInfoForMeshes = TArray<FGameplayAbilityLocalAnimMontageForMesh>();
-	RepAnimMontageInfoForMeshes = TArray<FGameplayAbilityRepAnimMontageForMesh>();
+
+	// Their EffectContexts point at the old AvatarActor
+	ReusableOutgoingSpecs.Reset();
+
+	// Clients keep what the server replicated to them, the server tells them when it's cleared
+	if (IsOwnerActorAuthoritative())
+	{
+		RepAnimMontageInfoForMeshes.Items.Reset();
+		RepAnimMontageInfoForMeshes.MarkArrayDirty();
+
+		BindReserveAmmoClamps();
+	}
 
 	if (bPendingMontageRep)
 	{
@@ -83,6 +115,8 @@ UGSAbilitySystemComponent* UGSAbilitySystemComponent::GetAbilitySystemComponentF
 
 void UGSAbilitySystemComponent::AbilityLocalInputPressed(int32 InputID)
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSAbilityLocalInputPressed);
+
 	// Consume the input if this InputID is overloaded with GenericConfirm/Cancel and the GenericConfim/Cancel callback is bound
 	if (IsGenericConfirmInputBound(InputID))
 	{
@@ -98,33 +132,48 @@ void UGSAbilitySystemComponent::AbilityLocalInputPressed(int32 InputID)
 
 	// ---------------------------------------------------------
 
+	if (bAbilitySpecIndexDirty)
+	{
+		RebuildAbilitySpecIndex();
+	}
+
+	const TArray<FGameplayAbilitySpecHandle>* FoundHandles = AbilitySpecHandlesByInputID.Find(InputID);
+	if (!FoundHandles)
+	{
+		return;
+	}
+
+	// Copy since activating can give or remove abilities once the scope lock is released
+	const TArray<FGameplayAbilitySpecHandle, TInlineAllocator<4>> Handles(*FoundHandles);
+
 	ABILITYLIST_SCOPE_LOCK();
-	for (FGameplayAbilitySpec& Spec : ActivatableAbilities.Items)
+	for (const FGameplayAbilitySpecHandle& Handle : Handles)
 	{
-		if (Spec.InputID == InputID)
+		FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandleIndexed(Handle);
+		if (Spec && Spec->InputID == InputID)
 		{
-			if (Spec.Ability)
+			if (Spec->Ability)
 			{
-				Spec.InputPressed = true;
-				if (Spec.IsActive())
+				Spec->InputPressed = true;
+				if (Spec->IsActive())
 				{
-					if (Spec.Ability->bReplicateInputDirectly && IsOwnerActorAuthoritative() == false)
+					if (Spec->Ability->bReplicateInputDirectly && IsOwnerActorAuthoritative() == false)
 					{
-						ServerSetInputPressed(Spec.Handle);
+						ServerSetInputPressed(Spec->Handle);
 					}
 
-					AbilitySpecInputPressed(Spec);
+					AbilitySpecInputPressed(*Spec);
 
 					// Invoke the InputPressed event. This is not replicated here. If someone is listening, they may replicate the InputPressed event to the server.
-					InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, Spec.Handle, Spec.ActivationInfo.GetActivationPredictionKey());
+					InvokeReplicatedEvent(EAbilityGenericReplicatedEvent::InputPressed, Spec->Handle, Spec->ActivationInfo.GetActivationPredictionKey());
 				}
 				else
 				{
-					UGSGameplayAbility* GA = Cast<UGSGameplayAbility>(Spec.Ability);
+					UGSGameplayAbility* GA = Cast<UGSGameplayAbility>(Spec->Ability);
 					if (GA && GA->bActivateOnInput)
 					{
 						// Ability is not active, so try to activate it
-						TryActivateAbility(Spec.Handle);
+						TryActivateAbility(Spec->Handle);
 					}
 				}
 			}
@@ -139,20 +188,130 @@ int32 UGSAbilitySystemComponent::K2_GetTagCount(FGameplayTag TagToCheck) const
 
 FGameplayAbilitySpecHandle UGSAbilitySystemComponent::FindAbilitySpecHandleForClass(TSubclassOf<UGameplayAbility> AbilityClass, UObject* OptionalSourceObject)
 {
-	ABILITYLIST_SCOPE_LOCK();
-	for (FGameplayAbilitySpec& Spec : ActivatableAbilities.Items)
+	if (bAbilitySpecIndexDirty)
+	{
+		RebuildAbilitySpecIndex();
+	}
+
+	const TArray<FGameplayAbilitySpecHandle>* Handles = AbilitySpecHandlesByClass.Find(AbilityClass.Get());
+	if (!Handles)
+	{
+		return FGameplayAbilitySpecHandle();
+	}
+
+	for (const FGameplayAbilitySpecHandle& Handle : *Handles)
 	{
-		TSubclassOf<UGameplayAbility> SpecAbilityClass = Spec.Ability->GetClass();
-		if (SpecAbilityClass == AbilityClass)
+		const FGameplayAbilitySpec* Spec = FindAbilitySpecFromHandleIndexed(Handle);
+		if (Spec && (!OptionalSourceObject || Spec->SourceObject == OptionalSourceObject))
 		{
-			if (!OptionalSourceObject || (OptionalSourceObject && Spec.SourceObject == OptionalSourceObject))
+			return Spec->Handle;
+		}
+	}
+
+	return FGameplayAbilitySpecHandle();
+}
+
+void UGSAbilitySystemComponent::MarkAbilitySpecIndexDirty()
+{
+	bAbilitySpecIndexDirty = true;
+}
+
+void UGSAbilitySystemComponent::OnGiveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	Super::OnGiveAbility(AbilitySpec);
+
+	if (bAbilitySpecIndexDirty || !AbilitySpec.Ability)
+	{
+		return;
+	}
+
+	const int32 Index = &AbilitySpec - ActivatableAbilities.Items.GetData();
+	if (!ActivatableAbilities.Items.IsValidIndex(Index))
+	{
+		bAbilitySpecIndexDirty = true;
+		return;
+	}
+
+	AbilitySpecHandlesByInputID.FindOrAdd(AbilitySpec.InputID).AddUnique(AbilitySpec.Handle);
+	AbilitySpecHandlesByClass.FindOrAdd(AbilitySpec.Ability->GetClass()).AddUnique(AbilitySpec.Handle);
+	AbilitySpecIndexByHandle.Add(AbilitySpec.Handle, Index);
+}
+
+void UGSAbilitySystemComponent::OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec)
+{
+	if (!bAbilitySpecIndexDirty)
+	{
+		if (TArray<FGameplayAbilitySpecHandle>* Handles = AbilitySpecHandlesByInputID.Find(AbilitySpec.InputID))
+		{
+			Handles->Remove(AbilitySpec.Handle);
+		}
+
+		if (AbilitySpec.Ability)
+		{
+			if (TArray<FGameplayAbilitySpecHandle>* Handles = AbilitySpecHandlesByClass.Find(AbilitySpec.Ability->GetClass()))
 			{
-				return Spec.Handle;
+				Handles->Remove(AbilitySpec.Handle);
 			}
 		}
+
+		// Removing from Items shifts other Specs. Their indices are fixed up when FindAbilitySpecFromHandleIndexed() misses.
+		AbilitySpecIndexByHandle.Remove(AbilitySpec.Handle);
 	}
 
-	return FGameplayAbilitySpecHandle();
+	Super::OnRemoveAbility(AbilitySpec);
+}
+
+void UGSAbilitySystemComponent::OnRep_ActivateAbilities()
+{
+	Super::OnRep_ActivateAbilities();
+
+	// Replication can change a Spec's InputID without going through OnGiveAbility/OnRemoveAbility
+	bAbilitySpecIndexDirty = true;
+}
+
+void UGSAbilitySystemComponent::RebuildAbilitySpecIndex()
+{
+	bAbilitySpecIndexDirty = false;
+
+	AbilitySpecHandlesByInputID.Reset();
+	AbilitySpecHandlesByClass.Reset();
+	AbilitySpecIndexByHandle.Reset();
+
+	for (int32 Index = 0; Index < ActivatableAbilities.Items.Num(); Index++)
+	{
+		const FGameplayAbilitySpec& Spec = ActivatableAbilities.Items[Index];
+		if (!Spec.Ability)
+		{
+			continue;
+		}
+
+		AbilitySpecHandlesByInputID.FindOrAdd(Spec.InputID).Add(Spec.Handle);
+		AbilitySpecHandlesByClass.FindOrAdd(Spec.Ability->GetClass()).Add(Spec.Handle);
+		AbilitySpecIndexByHandle.Add(Spec.Handle, Index);
+	}
+}
+
+FGameplayAbilitySpec* UGSAbilitySystemComponent::FindAbilitySpecFromHandleIndexed(FGameplayAbilitySpecHandle Handle)
+{
+	const int32* Index = AbilitySpecIndexByHandle.Find(Handle);
+	if (Index && ActivatableAbilities.Items.IsValidIndex(*Index) && ActivatableAbilities.Items[*Index].Handle == Handle)
+	{
+		return &ActivatableAbilities.Items[*Index];
+	}
+
+	// Items moved since we last indexed them
+	for (int32 ItemIndex = 0; ItemIndex < ActivatableAbilities.Items.Num(); ItemIndex++)
+	{
+		AbilitySpecIndexByHandle.Add(ActivatableAbilities.Items[ItemIndex].Handle, ItemIndex);
+	}
+
+	Index = AbilitySpecIndexByHandle.Find(Handle);
+	if (Index && ActivatableAbilities.Items.IsValidIndex(*Index) && ActivatableAbilities.Items[*Index].Handle == Handle)
+	{
+		return &ActivatableAbilities.Items[*Index];
+	}
+
+	return nullptr;
 }
 
 void UGSAbilitySystemComponent::K2_AddLooseGameplayTag(const FGameplayTag& GameplayTag, int32 Count)
@@ -177,6 +336,8 @@ void UGSAbilitySystemComponent::K2_RemoveLooseGameplayTags(const FGameplayTagCon
 
 bool UGSAbilitySystemComponent::BatchRPCTryActivateAbility(FGameplayAbilitySpecHandle InAbilityHandle, bool EndAbilityImmediately)
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSBatchRPCTryActivateAbility);
+
 	bool AbilityActivated = false;
 	if (InAbilityHandle.IsValid())
 	{
@@ -267,8 +428,54 @@ FActiveGameplayEffectHandle UGSAbilitySystemComponent::BP_ApplyGameplayEffectToT
 	return ApplyGameplayEffectToTarget(GameplayEffect, Target, Level, Context);
 }
 
+FGameplayEffectSpec* UGSAbilitySystemComponent::GetReusableOutgoingSpec(TSubclassOf<UGameplayEffect> GameplayEffectClass)
+{
+	if (!GameplayEffectClass)
+	{
+		return nullptr;
+	}
+
+	FGameplayEffectSpecHandle& SpecHandle = ReusableOutgoingSpecs.FindOrAdd(GameplayEffectClass.Get());
+	if (!SpecHandle.IsValid())
+	{
+		SpecHandle = MakeOutgoingSpec(GameplayEffectClass, 1.0f, MakeEffectContext());
+	}
+
+	return SpecHandle.Data.Get();
+}
+
+void UGSAbilitySystemComponent::BindReserveAmmoClamps()
+{
+	if (bReserveAmmoClampsBound)
+	{
+		return;
+	}
+
+	bReserveAmmoClampsBound = true;
+
+	for (const FGSAmmoTypeAttributes& AmmoType : UGSAmmoAttributeSet::GetAmmoTypes())
+	{
+		// UGSAmmoAttributeSet clamps its own in PostGameplayEffectExecute()
+		if (AmmoType.ReserveAmmoAttribute.GetAttributeSetClass() != UGSAmmoAttributeSet::StaticClass())
+		{
+			GetGameplayAttributeValueChangeDelegate(AmmoType.ReserveAmmoAttribute).AddUObject(this, &UGSAbilitySystemComponent::OnReserveAmmoChanged);
+		}
+	}
+}
+
+void UGSAbilitySystemComponent::OnReserveAmmoChanged(const FOnAttributeChangeData& Data)
+{
+	const FGSAmmoTypeAttributes* AmmoType = UGSAmmoAttributeSet::FindAmmoTypeByReserveAttribute(Data.Attribute);
+	if (AmmoType && IsOwnerActorAuthoritative())
+	{
+		UGSAmmoAttributeSet::ClampReserveAmmo(this, *AmmoType);
+	}
+}
+
 float UGSAbilitySystemComponent::PlayMontageForMesh(UGameplayAbility* InAnimatingAbility, USkeletalMeshComponent* InMesh, FGameplayAbilityActivationInfo ActivationInfo, UAnimMontage* NewAnimMontage, float InPlayRate, FName StartSectionName, bool bReplicateMontage)
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSMontagePlayForMesh);
+
 	UGSGameplayAbility* InAbility = Cast<UGSGameplayAbility>(InAnimatingAbility);
 
 	float Duration = -1.f;
@@ -321,6 +528,7 @@ float UGSAbilitySystemComponent::PlayMontageForMesh(UGameplayAbility* InAnimatin
 					FGameplayAbilityRepAnimMontageForMesh& AbilityRepMontageInfo = GetGameplayAbilityRepAnimMontageForMesh(InMesh);
 					AbilityRepMontageInfo.RepMontageInfo.AnimMontage = NewAnimMontage;
 					AbilityRepMontageInfo.RepMontageInfo.ForcePlayBit = !bool(AbilityRepMontageInfo.RepMontageInfo.ForcePlayBit);
+					RepAnimMontageInfoForMeshes.MarkItemDirty(AbilityRepMontageInfo);
 
 					// Update parameters that change during Montage life time.
 					AnimMontage_UpdateReplicatedDataForMesh(InMesh);
@@ -627,7 +835,7 @@ FGameplayAbilityLocalAnimMontageForMesh& UGSAbilitySystemComponent::GetLocalAnim
 
 FGameplayAbilityRepAnimMontageForMesh& UGSAbilitySystemComponent::GetGameplayAbilityRepAnimMontageForMesh(USkeletalMeshComponent* InMesh)
 {
-	for (FGameplayAbilityRepAnimMontageForMesh& RepMontageInfo : RepAnimMontageInfoForMeshes)
+	for (FGameplayAbilityRepAnimMontageForMesh& RepMontageInfo : RepAnimMontageInfoForMeshes.Items)
 	{
 		if (RepMontageInfo.Mesh == InMesh)
 		{
@@ -635,9 +843,9 @@ FGameplayAbilityRepAnimMontageForMesh& UGSAbilitySystemComponent::GetGameplayAbi
 		}
 	}
 
-	FGameplayAbilityRepAnimMontageForMesh RepMontageInfo = FGameplayAbilityRepAnimMontageForMesh(InMesh);
-	RepAnimMontageInfoForMeshes.Add(RepMontageInfo);
-	return RepAnimMontageInfoForMeshes.Last();
+	FGameplayAbilityRepAnimMontageForMesh& RepMontageInfo = RepAnimMontageInfoForMeshes.Items.Add_GetRef(FGameplayAbilityRepAnimMontageForMesh(InMesh));
+	RepAnimMontageInfoForMeshes.MarkItemDirty(RepMontageInfo);
+	return RepMontageInfo;
 }
 
 void UGSAbilitySystemComponent::OnPredictiveMontageRejectedForMesh(USkeletalMeshComponent* InMesh, UAnimMontage* PredictiveMontage)
@@ -664,12 +872,16 @@ void UGSAbilitySystemComponent::AnimMontage_UpdateReplicatedDataForMesh(USkeleta
 
 void UGSAbilitySystemComponent::AnimMontage_UpdateReplicatedDataForMesh(FGameplayAbilityRepAnimMontageForMesh& OutRepAnimMontageInfo)
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSMontageUpdateReplicatedData);
+
 	UAnimInstance* AnimInstance = IsValid(OutRepAnimMontageInfo.Mesh) && OutRepAnimMontageInfo.Mesh->GetOwner() 
 		== AbilityActorInfo->AvatarActor ? OutRepAnimMontageInfo.Mesh->GetAnimInstance() : nullptr;
 	FGameplayAbilityLocalAnimMontageForMesh& AnimMontageInfo = GetLocalAnimMontageInfoForMesh(OutRepAnimMontageInfo.Mesh);
 
 	if (AnimInstance && AnimMontageInfo.LocalMontageInfo.AnimMontage)
 	{
+		const FGameplayAbilityRepAnimMontage OldRepMontageInfo = OutRepAnimMontageInfo.RepMontageInfo;
+
 		OutRepAnimMontageInfo.RepMontageInfo.AnimMontage = AnimMontageInfo.LocalMontageInfo.AnimMontage;
 
 		// Compressed Flags
@@ -715,6 +927,19 @@ void UGSAbilitySystemComponent::AnimMontage_UpdateReplicatedDataForMesh(FGamepla
 		{
 			OutRepAnimMontageInfo.RepMontageInfo.NextSectionID = 0;
 		}
+
+		// Only send this mesh if something actually changed. We're called every tick while a montage plays.
+		const FGameplayAbilityRepAnimMontage& NewRepMontageInfo = OutRepAnimMontageInfo.RepMontageInfo;
+		if (NewRepMontageInfo.AnimMontage != OldRepMontageInfo.AnimMontage
+			|| NewRepMontageInfo.PlayRate != OldRepMontageInfo.PlayRate
+			|| NewRepMontageInfo.Position != OldRepMontageInfo.Position
+			|| NewRepMontageInfo.BlendTime != OldRepMontageInfo.BlendTime
+			|| NewRepMontageInfo.NextSectionID != OldRepMontageInfo.NextSectionID
+			|| NewRepMontageInfo.IsStopped != OldRepMontageInfo.IsStopped
+			|| NewRepMontageInfo.ForcePlayBit != OldRepMontageInfo.ForcePlayBit)
+		{
+			RepAnimMontageInfoForMeshes.MarkItemDirty(OutRepAnimMontageInfo);
+		}
 	}
 }
 
@@ -722,138 +947,151 @@ void UGSAbilitySystemComponent::AnimMontage_UpdateForcedPlayFlagsForMesh(FGamepl
 {
 	FGameplayAbilityLocalAnimMontageForMesh& AnimMontageInfo = GetLocalAnimMontageInfoForMesh(OutRepAnimMontageInfo.Mesh);
 
-	OutRepAnimMontageInfo.RepMontageInfo.ForcePlayBit = AnimMontageInfo.LocalMontageInfo.PlayBit;
+	if (OutRepAnimMontageInfo.RepMontageInfo.ForcePlayBit != AnimMontageInfo.LocalMontageInfo.PlayBit)
+	{
+		OutRepAnimMontageInfo.RepMontageInfo.ForcePlayBit = AnimMontageInfo.LocalMontageInfo.PlayBit;
+		RepAnimMontageInfoForMeshes.MarkItemDirty(OutRepAnimMontageInfo);
+	}
 }
 
 void UGSAbilitySystemComponent::OnRep_ReplicatedAnimMontageForMesh()
 {
-	for (FGameplayAbilityRepAnimMontageForMesh& NewRepMontageInfoForMesh : RepAnimMontageInfoForMeshes)
+	// Meshes that still can't be handled will set this again
+	bPendingMontageRep = false;
+
+	for (FGameplayAbilityRepAnimMontageForMesh& NewRepMontageInfoForMesh : RepAnimMontageInfoForMeshes.Items)
 	{
-		FGameplayAbilityLocalAnimMontageForMesh& AnimMontageInfo = GetLocalAnimMontageInfoForMesh(NewRepMontageInfoForMesh.Mesh);
+		OnRep_ReplicatedAnimMontageForMesh(NewRepMontageInfoForMesh);
+	}
+}
 
-		UWorld* World = GetWorld();
+void UGSAbilitySystemComponent::OnRep_ReplicatedAnimMontageForMesh(FGameplayAbilityRepAnimMontageForMesh& NewRepMontageInfoForMesh)
+{
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSMontageOnRep);
 
-		if (NewRepMontageInfoForMesh.RepMontageInfo.bSkipPlayRate)
-		{
-			NewRepMontageInfoForMesh.RepMontageInfo.PlayRate = 1.f;
-		}
+	FGameplayAbilityLocalAnimMontageForMesh& AnimMontageInfo = GetLocalAnimMontageInfoForMesh(NewRepMontageInfoForMesh.Mesh);
+
+	UWorld* World = GetWorld();
+
+	if (NewRepMontageInfoForMesh.RepMontageInfo.bSkipPlayRate)
+	{
+		NewRepMontageInfoForMesh.RepMontageInfo.PlayRate = 1.f;
+	}
+
+	const bool bIsPlayingReplay = World && World->IsPlayingReplay();
 
-		const bool bIsPlayingReplay = World && World->IsPlayingReplay();
+	const float MONTAGE_REP_POS_ERR_THRESH = bIsPlayingReplay ? CVarReplayMontageErrorThreshold.GetValueOnGameThread() : 0.1f;
 
-		const float MONTAGE_REP_POS_ERR_THRESH = bIsPlayingReplay ? CVarReplayMontageErrorThreshold.GetValueOnGameThread() : 0.1f;
+	UAnimInstance* AnimInstance = IsValid(NewRepMontageInfoForMesh.Mesh) && NewRepMontageInfoForMesh.Mesh->GetOwner()
+		== AbilityActorInfo->AvatarActor ? NewRepMontageInfoForMesh.Mesh->GetAnimInstance() : nullptr;
+	if (AnimInstance == nullptr || !IsReadyForReplicatedMontageForMesh())
+	{
+		// We can't handle this yet
+		bPendingMontageRep = true;
+		return;
+	}
 
-		UAnimInstance* AnimInstance = IsValid(NewRepMontageInfoForMesh.Mesh) && NewRepMontageInfoForMesh.Mesh->GetOwner()
-			== AbilityActorInfo->AvatarActor ? NewRepMontageInfoForMesh.Mesh->GetAnimInstance() : nullptr;
-		if (AnimInstance == nullptr || !IsReadyForReplicatedMontageForMesh())
+	if (!AbilityActorInfo->IsLocallyControlled())
+	{
+		static const auto CVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.Montage.Debug"));
+		bool DebugMontage = (CVar && CVar->GetValueOnGameThread() == 1);
+		if (DebugMontage)
 		{
-			// We can't handle this yet
-			bPendingMontageRep = true;
-			return;
+			ABILITY_LOG(Warning, TEXT("\n\nOnRep_ReplicatedAnimMontage, %s"), *GetNameSafe(this));
+			ABILITY_LOG(Warning, TEXT("\tAnimMontage: %s\n\tPlayRate: %f\n\tPosition: %f\n\tBlendTime: %f\n\tNextSectionID: %d\n\tIsStopped: %d\n\tForcePlayBit: %d"),
+				*GetNameSafe(NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage),
+				NewRepMontageInfoForMesh.RepMontageInfo.PlayRate,
+				NewRepMontageInfoForMesh.RepMontageInfo.Position,
+				NewRepMontageInfoForMesh.RepMontageInfo.BlendTime,
+				NewRepMontageInfoForMesh.RepMontageInfo.NextSectionID,
+				NewRepMontageInfoForMesh.RepMontageInfo.IsStopped,
+				NewRepMontageInfoForMesh.RepMontageInfo.ForcePlayBit);
+			ABILITY_LOG(Warning, TEXT("\tLocalAnimMontageInfo.AnimMontage: %s\n\tPosition: %f"),
+				*GetNameSafe(AnimMontageInfo.LocalMontageInfo.AnimMontage), AnimInstance->Montage_GetPosition(AnimMontageInfo.LocalMontageInfo.AnimMontage));
 		}
-		bPendingMontageRep = false;
 
-		if (!AbilityActorInfo->IsLocallyControlled())
+		if (NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage)
 		{
-			static const auto CVar = IConsoleManager::Get().FindTConsoleVariableDataInt(TEXT("net.Montage.Debug"));
-			bool DebugMontage = (CVar && CVar->GetValueOnGameThread() == 1);
-			if (DebugMontage)
+			// New Montage to play
+			const bool ReplicatedPlayBit = bool(NewRepMontageInfoForMesh.RepMontageInfo.ForcePlayBit);
+			if ((AnimMontageInfo.LocalMontageInfo.AnimMontage != NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage) || (AnimMontageInfo.LocalMontageInfo.PlayBit != ReplicatedPlayBit))
 			{
-				ABILITY_LOG(Warning, TEXT("\n\nOnRep_ReplicatedAnimMontage, %s"), *GetNameSafe(this));
-				ABILITY_LOG(Warning, TEXT("\tAnimMontage: %s\n\tPlayRate: %f\n\tPosition: %f\n\tBlendTime: %f\n\tNextSectionID: %d\n\tIsStopped: %d\n\tForcePlayBit: %d"),
-					*GetNameSafe(NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage),
-					NewRepMontageInfoForMesh.RepMontageInfo.PlayRate,
-					NewRepMontageInfoForMesh.RepMontageInfo.Position,
-					NewRepMontageInfoForMesh.RepMontageInfo.BlendTime,
-					NewRepMontageInfoForMesh.RepMontageInfo.NextSectionID,
-					NewRepMontageInfoForMesh.RepMontageInfo.IsStopped,
-					NewRepMontageInfoForMesh.RepMontageInfo.ForcePlayBit);
-				ABILITY_LOG(Warning, TEXT("\tLocalAnimMontageInfo.AnimMontage: %s\n\tPosition: %f"),
-					*GetNameSafe(AnimMontageInfo.LocalMontageInfo.AnimMontage), AnimInstance->Montage_GetPosition(AnimMontageInfo.LocalMontageInfo.AnimMontage));
+				AnimMontageInfo.LocalMontageInfo.PlayBit = ReplicatedPlayBit;
+				PlayMontageSimulatedForMesh(NewRepMontageInfoForMesh.Mesh, NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage, NewRepMontageInfoForMesh.RepMontageInfo.PlayRate);
 			}
 
-			if (NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage)
+			if (AnimMontageInfo.LocalMontageInfo.AnimMontage == nullptr)
 			{
-				// New Montage to play
-				const bool ReplicatedPlayBit = bool(NewRepMontageInfoForMesh.RepMontageInfo.ForcePlayBit);
-				if ((AnimMontageInfo.LocalMontageInfo.AnimMontage != NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage) || (AnimMontageInfo.LocalMontageInfo.PlayBit != ReplicatedPlayBit))
-				{
-					AnimMontageInfo.LocalMontageInfo.PlayBit = ReplicatedPlayBit;
-					PlayMontageSimulatedForMesh(NewRepMontageInfoForMesh.Mesh, NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage, NewRepMontageInfoForMesh.RepMontageInfo.PlayRate);
-				}
+				ABILITY_LOG(Warning, TEXT("OnRep_ReplicatedAnimMontage: PlayMontageSimulated failed. Name: %s, AnimMontage: %s"), *GetNameSafe(this), *GetNameSafe(NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage));
+				return;
+			}
 
-				if (AnimMontageInfo.LocalMontageInfo.AnimMontage == nullptr)
-				{
-					ABILITY_LOG(Warning, TEXT("OnRep_ReplicatedAnimMontage: PlayMontageSimulated failed. Name: %s, AnimMontage: %s"), *GetNameSafe(this), *GetNameSafe(NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage));
-					return;
-				}
+			// Play Rate has changed
+			if (AnimInstance->Montage_GetPlayRate(AnimMontageInfo.LocalMontageInfo.AnimMontage) != NewRepMontageInfoForMesh.RepMontageInfo.PlayRate)
+			{
+				AnimInstance->Montage_SetPlayRate(AnimMontageInfo.LocalMontageInfo.AnimMontage, NewRepMontageInfoForMesh.RepMontageInfo.PlayRate);
+			}
+
+			// Compressed Flags
+			const bool bIsStopped = AnimInstance->Montage_GetIsStopped(AnimMontageInfo.LocalMontageInfo.AnimMontage);
+			const bool bReplicatedIsStopped = bool(NewRepMontageInfoForMesh.RepMontageInfo.IsStopped);
 
-				// Play Rate has changed
-				if (AnimInstance->Montage_GetPlayRate(AnimMontageInfo.LocalMontageInfo.AnimMontage) != NewRepMontageInfoForMesh.RepMontageInfo.PlayRate)
+			// Process stopping first, so we don't change sections and cause blending to pop.
+			if (bReplicatedIsStopped)
+			{
+				if (!bIsStopped)
 				{
-					AnimInstance->Montage_SetPlayRate(AnimMontageInfo.LocalMontageInfo.AnimMontage, NewRepMontageInfoForMesh.RepMontageInfo.PlayRate);
+					CurrentMontageStopForMesh(NewRepMontageInfoForMesh.Mesh, NewRepMontageInfoForMesh.RepMontageInfo.BlendTime);
 				}
+			}
+			else if (!NewRepMontageInfoForMesh.RepMontageInfo.SkipPositionCorrection)
+			{
+				const int32 RepSectionID = AnimMontageInfo.LocalMontageInfo.AnimMontage->GetSectionIndexFromPosition(NewRepMontageInfoForMesh.RepMontageInfo.Position);
+				const int32 RepNextSectionID = int32(NewRepMontageInfoForMesh.RepMontageInfo.NextSectionID) - 1;
 
-				// Compressed Flags
-				const bool bIsStopped = AnimInstance->Montage_GetIsStopped(AnimMontageInfo.LocalMontageInfo.AnimMontage);
-				const bool bReplicatedIsStopped = bool(NewRepMontageInfoForMesh.RepMontageInfo.IsStopped);
-
-				// Process stopping first, so we don't change sections and cause blending to pop.
-				if (bReplicatedIsStopped)
+				// And NextSectionID for the replicated SectionID.
+				if (RepSectionID != INDEX_NONE)
 				{
-					if (!bIsStopped)
+					const int32 NextSectionID = AnimInstance->Montage_GetNextSectionID(AnimMontageInfo.LocalMontageInfo.AnimMontage, RepSectionID);
+
+					// If NextSectionID is different than the replicated one, then set it.
+					if (NextSectionID != RepNextSectionID)
 					{
-						CurrentMontageStopForMesh(NewRepMontageInfoForMesh.Mesh, NewRepMontageInfoForMesh.RepMontageInfo.BlendTime);
+						AnimInstance->Montage_SetNextSection(AnimMontageInfo.LocalMontageInfo.AnimMontage->GetSectionName(RepSectionID), AnimMontageInfo.LocalMontageInfo.AnimMontage->GetSectionName(RepNextSectionID), AnimMontageInfo.LocalMontageInfo.AnimMontage);
 					}
-				}
-				else if (!NewRepMontageInfoForMesh.RepMontageInfo.SkipPositionCorrection)
-				{
-					const int32 RepSectionID = AnimMontageInfo.LocalMontageInfo.AnimMontage->GetSectionIndexFromPosition(NewRepMontageInfoForMesh.RepMontageInfo.Position);
-					const int32 RepNextSectionID = int32(NewRepMontageInfoForMesh.RepMontageInfo.NextSectionID) - 1;
 
-					// And NextSectionID for the replicated SectionID.
-					if (RepSectionID != INDEX_NONE)
+					// Make sure we haven't received that update too late and the client hasn't already jumped to another section. 
+					const int32 CurrentSectionID = AnimMontageInfo.LocalMontageInfo.AnimMontage->GetSectionIndexFromPosition(AnimInstance->Montage_GetPosition(AnimMontageInfo.LocalMontageInfo.AnimMontage));
+					if ((CurrentSectionID != RepSectionID) && (CurrentSectionID != RepNextSectionID))
 					{
-						const int32 NextSectionID = AnimInstance->Montage_GetNextSectionID(AnimMontageInfo.LocalMontageInfo.AnimMontage, RepSectionID);
-
-						// If NextSectionID is different than the replicated one, then set it.
-						if (NextSectionID != RepNextSectionID)
-						{
-							AnimInstance->Montage_SetNextSection(AnimMontageInfo.LocalMontageInfo.AnimMontage->GetSectionName(RepSectionID), AnimMontageInfo.LocalMontageInfo.AnimMontage->GetSectionName(RepNextSectionID), AnimMontageInfo.LocalMontageInfo.AnimMontage);
-						}
-
-						// Make sure we haven't received that update too late and the client hasn't already jumped to another section. 
-						const int32 CurrentSectionID = AnimMontageInfo.LocalMontageInfo.AnimMontage->GetSectionIndexFromPosition(AnimInstance->Montage_GetPosition(AnimMontageInfo.LocalMontageInfo.AnimMontage));
-						if ((CurrentSectionID != RepSectionID) && (CurrentSectionID != RepNextSectionID))
-						{
-							// Client is in a wrong section, teleport him into the begining of the right section
-							const float SectionStartTime = AnimMontageInfo.LocalMontageInfo.AnimMontage->GetAnimCompositeSection(RepSectionID).GetTime();
-							AnimInstance->Montage_SetPosition(AnimMontageInfo.LocalMontageInfo.AnimMontage, SectionStartTime);
-						}
+						// Client is in a wrong section, teleport him into the begining of the right section
+						const float SectionStartTime = AnimMontageInfo.LocalMontageInfo.AnimMontage->GetAnimCompositeSection(RepSectionID).GetTime();
+						AnimInstance->Montage_SetPosition(AnimMontageInfo.LocalMontageInfo.AnimMontage, SectionStartTime);
 					}
+				}
 
-					// Update Position. If error is too great, jump to replicated position.
-					const float CurrentPosition = AnimInstance->Montage_GetPosition(AnimMontageInfo.LocalMontageInfo.AnimMontage);
-					const int32 CurrentSectionID = AnimMontageInfo.LocalMontageInfo.AnimMontage->GetSectionIndexFromPosition(CurrentPosition);
-					const float DeltaPosition = NewRepMontageInfoForMesh.RepMontageInfo.Position - CurrentPosition;
+				// Update Position. If error is too great, jump to replicated position.
+				const float CurrentPosition = AnimInstance->Montage_GetPosition(AnimMontageInfo.LocalMontageInfo.AnimMontage);
+				const int32 CurrentSectionID = AnimMontageInfo.LocalMontageInfo.AnimMontage->GetSectionIndexFromPosition(CurrentPosition);
+				const float DeltaPosition = NewRepMontageInfoForMesh.RepMontageInfo.Position - CurrentPosition;
 
-					// Only check threshold if we are located in the same section. Different sections require a bit more work as we could be jumping around the timeline.
-					// And therefore DeltaPosition is not as trivial to determine.
-					if ((CurrentSectionID == RepSectionID) && (FMath::Abs(DeltaPosition) > MONTAGE_REP_POS_ERR_THRESH) && (NewRepMontageInfoForMesh.RepMontageInfo.IsStopped == 0))
+				// Only check threshold if we are located in the same section. Different sections require a bit more work as we could be jumping around the timeline.
+				// And therefore DeltaPosition is not as trivial to determine.
+				if ((CurrentSectionID == RepSectionID) && (FMath::Abs(DeltaPosition) > MONTAGE_REP_POS_ERR_THRESH) && (NewRepMontageInfoForMesh.RepMontageInfo.IsStopped == 0))
+				{
+					// fast forward to server position and trigger notifies
+					if (FAnimMontageInstance* MontageInstance = AnimInstance->GetActiveInstanceForMontage(NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage))
 					{
-						// fast forward to server position and trigger notifies
-						if (FAnimMontageInstance* MontageInstance = AnimInstance->GetActiveInstanceForMontage(NewRepMontageInfoForMesh.RepMontageInfo.AnimMontage))
+						// Skip triggering notifies if we're going backwards in time, we've already triggered them.
+						const float DeltaTime = !FMath::IsNearlyZero(NewRepMontageInfoForMesh.RepMontageInfo.PlayRate) ? (DeltaPosition / NewRepMontageInfoForMesh.RepMontageInfo.PlayRate) : 0.f;
+						if (DeltaTime >= 0.f)
 						{
-							// Skip triggering notifies if we're going backwards in time, we've already triggered them.
-							const float DeltaTime = !FMath::IsNearlyZero(NewRepMontageInfoForMesh.RepMontageInfo.PlayRate) ? (DeltaPosition / NewRepMontageInfoForMesh.RepMontageInfo.PlayRate) : 0.f;
-							if (DeltaTime >= 0.f)
-							{
-								MontageInstance->UpdateWeight(DeltaTime);
-								MontageInstance->HandleEvents(CurrentPosition, NewRepMontageInfoForMesh.RepMontageInfo.Position, nullptr);
-								AnimInstance->TriggerAnimNotifies(DeltaTime);
-							}
+							MontageInstance->UpdateWeight(DeltaTime);
+							MontageInstance->HandleEvents(CurrentPosition, NewRepMontageInfoForMesh.RepMontageInfo.Position, nullptr);
+							AnimInstance->TriggerAnimNotifies(DeltaTime);
 						}
-						AnimInstance->Montage_SetPosition(AnimMontageInfo.LocalMontageInfo.AnimMontage, NewRepMontageInfoForMesh.RepMontageInfo.Position);
 					}
+					AnimInstance->Montage_SetPosition(AnimMontageInfo.LocalMontageInfo.AnimMontage, NewRepMontageInfoForMesh.RepMontageInfo.Position);
 				}
 			}
 		}
@@ -3,10 +3,13 @@
 
 #include "Characters/Abilities/GSAbilitySystemGlobals.h"
 #include "Characters/Abilities/GSGameplayEffectTypes.h"
+#include "Characters/Abilities/GSGE_AmmoGrant.h"
+#include "Characters/Abilities/GSGE_Bounty.h"
 
 UGSAbilitySystemGlobals::UGSAbilitySystemGlobals()
 {
-
+	AmmoGrantEffect = UGSGE_AmmoGrant::StaticClass();
+	BountyEffect = UGSGE_Bounty::StaticClass();
 }
 
 FGameplayEffectContext* UGSAbilitySystemGlobals::AllocGameplayEffectContext() const
@@ -22,4 +25,6 @@ void UGSAbilitySystemGlobals::InitGlobalTags()
 	KnockedDownTag = FGameplayTag::RequestGameplayTag("State.KnockedDown");
 	InteractingTag = FGameplayTag::RequestGameplayTag("State.Interacting");
 	InteractingRemovalTag = FGameplayTag::RequestGameplayTag("State.InteractingRemoval");
+	XPBountyTag = FGameplayTag::RequestGameplayTag("Data.Bounty.XP");
+	GoldBountyTag = FGameplayTag::RequestGameplayTag("Data.Bounty.Gold");
 }
@@ -4,6 +4,7 @@
 #include "Characters/Abilities/GSDamageExecutionCalc.h"
 #include "Characters/Abilities/AttributeSets/GSAttributeSetBase.h"
 #include "Characters/Abilities/GSAbilitySystemComponent.h"
+#include "GSStats.h"
 
 // Declare the attributes to capture and define how we want to capture them from the Source and Target.
 struct GSDamageStatics
@@ -33,14 +34,74 @@ static const GSDamageStatics& DamageStatics()
 
 UGSDamageExecutionCalc::UGSDamageExecutionCalc()
 {
-	HeadShotMultiplier = 1.5f;
+	HeadBoneName = FName("b_head");
+	HitZoneMultipliers.Add(HeadBoneName, 1.5f);
+	HeadHitZoneIndex = INDEX_NONE;
+
+	DamageTag = FGameplayTag::RequestGameplayTag("Data.Damage");
+	CanHeadShotTag = FGameplayTag::RequestGameplayTag("Effect.Damage.CanHeadShot");
+	HeadShotTag = FGameplayTag::RequestGameplayTag("Effect.Damage.HeadShot");
 
 	RelevantAttributesToCapture.Add(DamageStatics().DamageDef);
 	RelevantAttributesToCapture.Add(DamageStatics().ArmorDef);
 }
 
+void UGSDamageExecutionCalc::PostInitProperties()
+{
+	Super::PostInitProperties();
+
+	BuildHitZoneLookup();
+}
+
+void UGSDamageExecutionCalc::PostLoad()
+{
+	Super::PostLoad();
+
+	// Blueprint subclasses may have changed the HitZoneMultipliers
+	BuildHitZoneLookup();
+}
+
+#if WITH_EDITOR
+void UGSDamageExecutionCalc::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	BuildHitZoneLookup();
+}
+#endif
+
+void UGSDamageExecutionCalc::BuildHitZoneLookup()
+{
+	HitZoneBoneNames.Reset(HitZoneMultipliers.Num());
+	HitZoneBoneMultipliers.Reset(HitZoneMultipliers.Num());
+	HeadHitZoneIndex = INDEX_NONE;
+
+	for (const TPair<FName, float>& HitZone : HitZoneMultipliers)
+	{
+		if (HitZone.Key == HeadBoneName)
+		{
+			HeadHitZoneIndex = HitZoneBoneNames.Num();
+		}
+
+		HitZoneBoneNames.Add(HitZone.Key);
+		HitZoneBoneMultipliers.Add(HitZone.Value);
+	}
+}
+
+int32 UGSDamageExecutionCalc::FindHitZone(const FName& BoneName) const
+{
+	if (BoneName == NAME_None)
+	{
+		return INDEX_NONE;
+	}
+
+	return HitZoneBoneNames.IndexOfByKey(BoneName);
+}
+
 void UGSDamageExecutionCalc::Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, OUT FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSDamageExecution);
+
 	UAbilitySystemComponent* TargetAbilitySystemComponent = ExecutionParams.GetTargetAbilitySystemComponent();
 	UAbilitySystemComponent* SourceAbilitySystemComponent = ExecutionParams.GetSourceAbilitySystemComponent();
 
@@ -48,8 +109,6 @@ void UGSDamageExecutionCalc::Execute_Implementation(const FGameplayEffectCustomE
 	AActor* TargetActor = TargetAbilitySystemComponent ? TargetAbilitySystemComponent->GetAvatarActor() : nullptr;
 
 	const FGameplayEffectSpec& Spec = ExecutionParams.GetOwningSpec();
-	FGameplayTagContainer AssetTags;
-	Spec.GetAllAssetTags(AssetTags);
 
 	// Gather the tags from the source and target as that can affect which buffs should be used
 	const FGameplayTagContainer* SourceTags = Spec.CapturedSourceTags.GetAggregatedTags();
@@ -67,17 +126,26 @@ void UGSDamageExecutionCalc::Execute_Implementation(const FGameplayEffectCustomE
 	// Capture optional damage value set on the damage GE as a CalculationModifier under the ExecutionCalculation
 	ExecutionParams.AttemptCalculateCapturedAttributeMagnitude(DamageStatics().DamageDef, EvaluationParameters, Damage);
 	// Add SetByCaller damage if it exists
-	Damage += FMath::Max<float>(Spec.GetSetByCallerMagnitude(FGameplayTag::RequestGameplayTag(FName("Data.Damage")), false, -1.0f), 0.0f);
+	Damage += FMath::Max<float>(Spec.GetSetByCallerMagnitude(DamageTag, false, -1.0f), 0.0f);
 
 	float UnmitigatedDamage = Damage; // Can multiply any damage boosters here
 
-	// Check for headshot. There's only one character mesh here, but you could have a function on your Character class to return the head bone name
+	// Check for hit zones like headshots. There's only one character mesh here, but you could have a function on your Character class to return the hit zone bone names
 	const FHitResult* Hit = Spec.GetContext().GetHitResult();
-	if (AssetTags.HasTagExact(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.CanHeadShot"))) && Hit && Hit->BoneName == "b_head")
+	const int32 HitZoneIndex = Hit ? FindHitZone(Hit->BoneName) : INDEX_NONE;
+	if (HitZoneIndex != INDEX_NONE)
 	{
-		UnmitigatedDamage *= HeadShotMultiplier;
-		FGameplayEffectSpec* MutableSpec = ExecutionParams.GetOwningSpecForPreExecuteMod();
-		MutableSpec->DynamicAssetTags.AddTag(FGameplayTag::RequestGameplayTag(FName("Effect.Damage.HeadShot")));
+		if (HitZoneIndex != HeadHitZoneIndex)
+		{
+			UnmitigatedDamage *= HitZoneBoneMultipliers[HitZoneIndex];
+		}
+		else if (Spec.DynamicAssetTags.HasTagExact(CanHeadShotTag) || (Spec.Def && Spec.Def->InheritableGameplayEffectTags.CombinedTags.HasTagExact(CanHeadShotTag)))
+		{
+			// Same as checking GetAllAssetTags() without building a new container
+			UnmitigatedDamage *= HitZoneBoneMultipliers[HitZoneIndex];
+			FGameplayEffectSpec* MutableSpec = ExecutionParams.GetOwningSpecForPreExecuteMod();
+			MutableSpec->DynamicAssetTags.AddTag(HeadShotTag);
+		}
 	}
 
 	float MitigatedDamage = (UnmitigatedDamage) * (100 / (100 + Armor));
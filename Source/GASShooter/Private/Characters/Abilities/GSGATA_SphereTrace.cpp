@@ -68,30 +68,11 @@ void AGSGATA_SphereTrace::SphereTraceWithFilter(TArray<FHitResult>& OutHitResult
 {
 	check(World);
 
-	TArray<FHitResult> HitResults;
-	World->SweepMultiByProfile(HitResults, Start, End, FQuat::Identity, ProfileName, FCollisionShape::MakeSphere(Radius), Params);
+	// Trace straight into the output and filter in place so that we reuse its allocation
+	OutHitResults.Reset();
+	World->SweepMultiByProfile(OutHitResults, Start, End, FQuat::Identity, ProfileName, FCollisionShape::MakeSphere(Radius), Params);
 
-	TArray<FHitResult> FilteredHitResults;
-
-	// Start param could be player ViewPoint. We want HitResult to always display the StartLocation.
-	FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
-
-	for (int32 HitIdx = 0; HitIdx < HitResults.Num(); ++HitIdx)
-	{
-		FHitResult& Hit = HitResults[HitIdx];
-
-		if (!Hit.Actor.IsValid() || FilterHandle.FilterPassesForActor(Hit.Actor))
-		{
-			Hit.TraceStart = TraceStart;
-			Hit.TraceEnd = End;
-
-			FilteredHitResults.Add(Hit);
-		}
-	}
-
-	OutHitResults = FilteredHitResults;
-
-	return;
+	FilterHitResults(OutHitResults, FilterHandle, End);
 }
 
 void AGSGATA_SphereTrace::DoTrace(TArray<FHitResult>& HitResults, const UWorld* World, const FGameplayTargetDataFilterHandle FilterHandle, const FVector& Start, const FVector& End, FName ProfileName, const FCollisionQueryParams Params)
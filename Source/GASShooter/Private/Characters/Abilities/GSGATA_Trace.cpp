@@ -6,6 +6,7 @@
 #include "DrawDebugHelpers.h"
 #include "GameFramework/PlayerController.h"
 #include "GameplayAbilitySpec.h"
+#include "GSStats.h"
 
 AGSGATA_Trace::AGSGATA_Trace()
 {
@@ -14,6 +15,7 @@ AGSGATA_Trace::AGSGATA_Trace()
 	PrimaryActorTick.TickGroup = TG_PostUpdateWork;
 	MaxHitResultsPerTrace = 1;
 	NumberOfTraces = 1;
+	bBatchPelletTraces = true;
 	bIgnoreBlockingHits = false;
 	bTraceAffectsAimPitch = true;
 	bTraceFromPlayerViewPoint = false;
@@ -25,6 +27,8 @@ AGSGATA_Trace::AGSGATA_Trace()
 	TargetingSpreadMax = 0.0f;
 	CurrentTargetingSpread = 0.0f;
 	bUsePersistentHitResults = false;
+	bSpawnedReticlesProduceTargetDataOnServer = false;
+	LastTraceBytesAllocated = 0;
 }
 
 void AGSGATA_Trace::ResetSpread()
@@ -77,16 +81,38 @@ void AGSGATA_Trace::StartTargeting(UGameplayAbility* Ability)
 	OwningAbility = Ability;
 	SourceActor = Ability->GetCurrentActorInfo()->AvatarActor.Get();
 
-	// This is a lazy way of emptying and repopulating the ReticleActors.
-	// We could come up with a solution that reuses them.
-	DestroyReticleActors();
+	// ReticleActors persist between targeting sessions. Only throw them away if they were spawned for a different
+	// reticle or replication setup, otherwise reuse them and only spawn more if we need more than last time.
+	if (ReticleActors.Num() > 0 && (SpawnedReticleClass != ReticleClass || bSpawnedReticlesProduceTargetDataOnServer != ShouldProduceTargetDataOnServer))
+	{
+		DestroyReticleActors();
+	}
 
 	if (ReticleClass)
 	{
-		for (int32 i = 0; i < MaxHitResultsPerTrace * NumberOfTraces; i++)
+		for (int32 i = ReticleActors.Num() - 1; i >= 0; i--)
+		{
+			AGameplayAbilityWorldReticle* LocalReticleActor = ReticleActors[i].Get();
+			if (!LocalReticleActor)
+			{
+				ReticleActors.RemoveAtSwap(i);
+				continue;
+			}
+
+			// MasterPC and ReticleParams can change between targeting sessions
+			LocalReticleActor->InitializeReticle(this, MasterPC, ReticleParams);
+			LocalReticleActor->SetIsTargetAnActor(false);
+			LocalReticleActor->SetActorHiddenInGame(true);
+		}
+
+		const int32 NumReticlesNeeded = MaxHitResultsPerTrace * NumberOfTraces;
+		for (int32 i = ReticleActors.Num(); i < NumReticlesNeeded; i++)
 		{
 			SpawnReticleActor(GetActorLocation(), GetActorRotation());
 		}
+
+		SpawnedReticleClass = ReticleClass;
+		bSpawnedReticlesProduceTargetDataOnServer = ShouldProduceTargetDataOnServer;
 	}
 
 	if (bUsePersistentHitResults)
@@ -97,6 +123,8 @@ void AGSGATA_Trace::StartTargeting(UGameplayAbility* Ability)
 
 void AGSGATA_Trace::ConfirmTargetingAndContinue()
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSTraceConfirmTargeting);
+
 	check(ShouldProduceTargetData());
 	if (SourceActor)
 	{
@@ -159,6 +187,8 @@ void AGSGATA_Trace::EndPlay(const EEndPlayReason::Type EndPlayReason)
 
 void AGSGATA_Trace::Tick(float DeltaSeconds)
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSTraceTick);
+
 	Super::Tick(DeltaSeconds);
 
 	TArray<FHitResult> HitResults;
@@ -180,30 +210,40 @@ void AGSGATA_Trace::LineTraceWithFilter(TArray<FHitResult>& OutHitResults, const
 {
 	check(World);
 
-	TArray<FHitResult> HitResults;
-	World->LineTraceMultiByProfile(HitResults, Start, End, ProfileName, Params);
+	// Trace straight into the output and filter in place so that we reuse its allocation
+	OutHitResults.Reset();
+	World->LineTraceMultiByProfile(OutHitResults, Start, End, ProfileName, Params);
 
-	TArray<FHitResult> FilteredHitResults;
+	FilterHitResults(OutHitResults, FilterHandle, End);
+}
 
+void AGSGATA_Trace::FilterHitResults(TArray<FHitResult>& InOutHitResults, const FGameplayTargetDataFilterHandle& FilterHandle, const FVector& End) const
+{
 	// Start param could be player ViewPoint. We want HitResult to always display the StartLocation.
-	FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
+	const FVector TraceStart = StartLocation.GetTargetingTransform().GetLocation();
+
+	int32 NumFilteredHitResults = 0;
 
-	for (int32 HitIdx = 0; HitIdx < HitResults.Num(); ++HitIdx)
+	for (int32 HitIdx = 0; HitIdx < InOutHitResults.Num(); ++HitIdx)
 	{
-		FHitResult& Hit = HitResults[HitIdx];
+		FHitResult& Hit = InOutHitResults[HitIdx];
 
 		if (!Hit.Actor.IsValid() || FilterHandle.FilterPassesForActor(Hit.Actor))
 		{
 			Hit.TraceStart = TraceStart;
 			Hit.TraceEnd = End;
 
-			FilteredHitResults.Add(Hit);
+			// Compact passing hits to the front, keeping their order
+			if (NumFilteredHitResults != HitIdx)
+			{
+				InOutHitResults[NumFilteredHitResults] = MoveTemp(Hit);
+			}
+
+			NumFilteredHitResults++;
 		}
 	}
 
-	OutHitResults = FilteredHitResults;
-
-	return;
+	InOutHitResults.SetNum(NumFilteredHitResults, false);
 }
 
 void AGSGATA_Trace::AimWithPlayerController(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart, FVector& OutTraceEnd, bool bIgnorePitch)
@@ -213,6 +253,54 @@ void AGSGATA_Trace::AimWithPlayerController(const AActor* InSourceActor, FCollis
 		return;
 	}
 
+	const FVector AdjustedAimDir = GetAdjustedAimDirection(InSourceActor, Params, TraceStart);
+
+	CurrentTargetingSpread = FMath::Min(TargetingSpreadMax, CurrentTargetingSpread + TargetingSpreadIncrement);
+
+	const float CurrentSpread = GetCurrentSpread();
+
+	const float ConeHalfAngle = FMath::DegreesToRadians(CurrentSpread * 0.5f);
+	const int32 RandomSeed = FMath::Rand();
+	FRandomStream WeaponRandomStream(RandomSeed);
+	const FVector ShootDir = WeaponRandomStream.VRandCone(AdjustedAimDir, ConeHalfAngle, ConeHalfAngle);
+
+	OutTraceEnd = TraceStart + (ShootDir * MaxRange);
+}
+
+bool AGSGATA_Trace::AimPelletsWithPlayerController(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart, int32 NumPellets, TArray<FVector>& OutTraceEnds)
+{
+	OutTraceEnds.Reset();
+
+	if (!OwningAbility) // Server and launching client only
+	{
+		return false;
+	}
+
+	// Every pellet shares the same aim point so we only need to trace from the camera once
+	const FVector AdjustedAimDir = GetAdjustedAimDirection(InSourceActor, Params, TraceStart);
+
+	// One stream for the whole volley
+	const int32 RandomSeed = FMath::Rand();
+	FRandomStream WeaponRandomStream(RandomSeed);
+
+	OutTraceEnds.Reserve(NumPellets);
+
+	for (int32 PelletIndex = 0; PelletIndex < NumPellets; PelletIndex++)
+	{
+		// Keep the same spread progression as tracing each pellet individually
+		CurrentTargetingSpread = FMath::Min(TargetingSpreadMax, CurrentTargetingSpread + TargetingSpreadIncrement);
+
+		const float ConeHalfAngle = FMath::DegreesToRadians(GetCurrentSpread() * 0.5f);
+		const FVector ShootDir = WeaponRandomStream.VRandCone(AdjustedAimDir, ConeHalfAngle, ConeHalfAngle);
+
+		OutTraceEnds.Add(TraceStart + (ShootDir * MaxRange));
+	}
+
+	return true;
+}
+
+FVector AGSGATA_Trace::GetAdjustedAimDirection(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart)
+{
 	// Default values in case of AI Controller
 	FVector ViewStart = TraceStart;
 	FRotator ViewRot = StartLocation.GetTargetingTransform().GetRotation().Rotator();
@@ -228,11 +316,9 @@ void AGSGATA_Trace::AimWithPlayerController(const AActor* InSourceActor, FCollis
 	ClipCameraRayToAbilityRange(ViewStart, ViewDir, TraceStart, MaxRange, ViewEnd);
 
 	// Use first hit
-	TArray<FHitResult> HitResults;
+	TArray<FHitResult>& HitResults = ScratchAimHitResults;
 	LineTraceWithFilter(HitResults, InSourceActor->GetWorld(), Filter, ViewStart, ViewEnd, TraceProfile.Name, Params);
 
-	CurrentTargetingSpread = FMath::Min(TargetingSpreadMax, CurrentTargetingSpread + TargetingSpreadIncrement);
-
 	const bool bUseTraceResult = HitResults.Num() > 0 && (FVector::DistSquared(TraceStart, HitResults[0].Location) <= (MaxRange * MaxRange));
 
 	const FVector AdjustedEnd = (bUseTraceResult) ? HitResults[0].Location : ViewEnd;
@@ -259,14 +345,7 @@ void AGSGATA_Trace::AimWithPlayerController(const AActor* InSourceActor, FCollis
 		}
 	}
 
-	const float CurrentSpread = GetCurrentSpread();
-
-	const float ConeHalfAngle = FMath::DegreesToRadians(CurrentSpread * 0.5f);
-	const int32 RandomSeed = FMath::Rand();
-	FRandomStream WeaponRandomStream(RandomSeed);
-	const FVector ShootDir = WeaponRandomStream.VRandCone(AdjustedAimDir, ConeHalfAngle, ConeHalfAngle);
-
-	OutTraceEnd = TraceStart + (ShootDir * MaxRange);
+	return AdjustedAimDir;
 }
 
 bool AGSGATA_Trace::ClipCameraRayToAbilityRange(FVector CameraLocation, FVector CameraDirection, FVector AbilityCenter, float AbilityRange, FVector& ClippedPosition)
@@ -292,7 +371,8 @@ void AGSGATA_Trace::StopTargeting()
 {
 	SetActorTickEnabled(false);
 
-	DestroyReticleActors();
+	// Keep the ReticleActors around for the next time we start targeting
+	HideReticleActors();
 
 	// Clear added callbacks
 	TargetDataReadyDelegate.Clear();
@@ -306,6 +386,24 @@ void AGSGATA_Trace::StopTargeting()
 	}
 }
 
+void AGSGATA_Trace::ResetForReuse()
+{
+	StopTargeting();
+	ResetSpread();
+
+	const AGSGATA_Trace* DefaultTargetActor = GetClass()->GetDefaultObject<AGSGATA_Trace>();
+	bBatchPelletTraces = DefaultTargetActor->bBatchPelletTraces;
+	bDebug = DefaultTargetActor->bDebug;
+	StartLocation = DefaultTargetActor->StartLocation;
+	Filter = DefaultTargetActor->Filter;
+
+	PersistentHitResults.Reset();
+	OwningAbility = nullptr;
+	SourceActor = nullptr;
+	MasterPC = nullptr;
+	SetOwner(nullptr);
+}
+
 FGameplayAbilityTargetDataHandle AGSGATA_Trace::MakeTargetData(const TArray<FHitResult>& HitResults) const
 {
 	FGameplayAbilityTargetDataHandle ReturnDataHandle;
@@ -323,6 +421,10 @@ FGameplayAbilityTargetDataHandle AGSGATA_Trace::MakeTargetData(const TArray<FHit
 
 TArray<FHitResult> AGSGATA_Trace::PerformTrace(AActor* InSourceActor)
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSTracePerformTrace);
+
+	const SIZE_T ScratchBytesBeforeTrace = GetScratchAllocatedSize();
+
 	bool bTraceComplex = false;
 	TArray<AActor*> ActorsToIgnore;
 
@@ -361,18 +463,37 @@ TArray<FHitResult> AGSGATA_Trace::PerformTrace(AActor* InSourceActor)
 	}
 
 	TArray<FHitResult> ReturnHitResults;
+	ReturnHitResults.Reserve(NumberOfTraces * FMath::Max(MaxHitResultsPerTrace, 1));
+
+	// Reminder: if bUsePersistentHitResults, Number of Traces = 1
+	const bool bBatchPellets = bBatchPelletTraces && NumberOfTraces > 1 && !bUsePersistentHitResults
+		&& AimPelletsWithPlayerController(InSourceActor, Params, TraceStart, NumberOfTraces, ScratchPelletTraceEnds);		//Effective on server and launching client only
+
+	if (bBatchPellets)
+	{
+		// Only the last pellet's end matters for the TargetActor's location, don't move it per pellet
+		SetActorLocationAndRotation(ScratchPelletTraceEnds.Last(), SourceActor->GetActorRotation());
+	}
 
 	for (int32 TraceIndex = 0; TraceIndex < NumberOfTraces; TraceIndex++)
 	{
-		AimWithPlayerController(InSourceActor, Params, TraceStart, TraceEnd);		//Effective on server and launching client only
+		if (bBatchPellets)
+		{
+			TraceEnd = ScratchPelletTraceEnds[TraceIndex];
+		}
+		else
+		{
+			AimWithPlayerController(InSourceActor, Params, TraceStart, TraceEnd);		//Effective on server and launching client only
 
-		// ------------------------------------------------------
+			SetActorLocationAndRotation(TraceEnd, SourceActor->GetActorRotation());
+		}
 
-		SetActorLocationAndRotation(TraceEnd, SourceActor->GetActorRotation());
+		// ------------------------------------------------------
 
 		CurrentTraceEnd = TraceEnd;
 
-		TArray<FHitResult> TraceHitResults;
+		TArray<FHitResult>& TraceHitResults = ScratchTraceHitResults;
+		TraceHitResults.Reset();
 		DoTrace(TraceHitResults, InSourceActor->GetWorld(), Filter, TraceStart, TraceEnd, TraceProfile.Name, Params);
 
 		for (int32 j = TraceHitResults.Num() - 1; j >= 0; j--)
@@ -529,12 +650,30 @@ TArray<FHitResult> AGSGATA_Trace::PerformTrace(AActor* InSourceActor)
 			}
 		}
 
+		RecordScratchAllocations(ScratchBytesBeforeTrace);
+
 		return PersistentHitResults;
 	}
 
+	RecordScratchAllocations(ScratchBytesBeforeTrace);
+
 	return ReturnHitResults;
 }
 
+SIZE_T AGSGATA_Trace::GetScratchAllocatedSize() const
+{
+	return ScratchTraceHitResults.GetAllocatedSize() + ScratchAimHitResults.GetAllocatedSize() + ScratchPelletTraceEnds.GetAllocatedSize();
+}
+
+void AGSGATA_Trace::RecordScratchAllocations(SIZE_T ScratchBytesBeforeTrace)
+{
+	// Scratch buffers only grow, so anything above what we had before the trace was allocated by it
+	const SIZE_T ScratchBytesAfterTrace = GetScratchAllocatedSize();
+	LastTraceBytesAllocated = ScratchBytesAfterTrace > ScratchBytesBeforeTrace ? static_cast<int32>(ScratchBytesAfterTrace - ScratchBytesBeforeTrace) : 0;
+
+	GS_COUNT_ALLOCATIONS(STAT_GSTraceScratchBytesAllocated, LastTraceBytesAllocated);
+}
+
 AGameplayAbilityWorldReticle* AGSGATA_Trace::SpawnReticleActor(FVector Location, FRotator Rotation)
 {
 	if (ReticleClass)
@@ -563,6 +702,18 @@ AGameplayAbilityWorldReticle* AGSGATA_Trace::SpawnReticleActor(FVector Location,
 	return nullptr;
 }
 
+void AGSGATA_Trace::HideReticleActors()
+{
+	for (TWeakObjectPtr<AGameplayAbilityWorldReticle>& ReticleActor : ReticleActors)
+	{
+		if (AGameplayAbilityWorldReticle* LocalReticleActor = ReticleActor.Get())
+		{
+			LocalReticleActor->SetIsTargetAnActor(false);
+			LocalReticleActor->SetActorHiddenInGame(true);
+		}
+	}
+}
+
 void AGSGATA_Trace::DestroyReticleActors()
 {
 	for (int32 i = ReticleActors.Num() - 1; i >= 0; i--)
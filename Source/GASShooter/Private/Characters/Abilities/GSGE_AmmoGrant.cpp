@@ -0,0 +1,31 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Characters/Abilities/GSGE_AmmoGrant.h"
+#include "Characters/Abilities/AttributeSets/GSAmmoAttributeSet.h"
+
+UGSGE_AmmoGrant::UGSGE_AmmoGrant()
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+}
+
+void UGSGE_AmmoGrant::RefreshAmmoModifiers()
+{
+	Modifiers.Reset();
+
+	for (const FGSAmmoTypeAttributes& AmmoType : UGSAmmoAttributeSet::GetAmmoTypes())
+	{
+		AddReserveAmmoModifier(AmmoType.ReserveAmmoAttribute, AmmoType.AmmoTag);
+	}
+}
+
+void UGSGE_AmmoGrant::AddReserveAmmoModifier(const FGameplayAttribute& ReserveAmmoAttribute, const FGameplayTag& AmmoTypeTag)
+{
+	FSetByCallerFloat SetByCaller;
+	SetByCaller.DataTag = AmmoTypeTag;
+
+	FGameplayModifierInfo& ModifierInfo = Modifiers.AddDefaulted_GetRef();
+	ModifierInfo.ModifierMagnitude = FGameplayEffectModifierMagnitude(SetByCaller);
+	ModifierInfo.ModifierOp = EGameplayModOp::Additive;
+	ModifierInfo.Attribute = ReserveAmmoAttribute;
+}
@@ -0,0 +1,26 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Characters/Abilities/GSGE_Bounty.h"
+#include "Characters/Abilities/AttributeSets/GSAttributeSetBase.h"
+
+UGSGE_Bounty::UGSGE_Bounty()
+{
+	DurationPolicy = EGameplayEffectDurationType::Instant;
+
+	FSetByCallerFloat XPSetByCaller;
+	XPSetByCaller.DataTag = FGameplayTag::RequestGameplayTag("Data.Bounty.XP");
+
+	FGameplayModifierInfo& InfoXP = Modifiers.AddDefaulted_GetRef();
+	InfoXP.ModifierMagnitude = FGameplayEffectModifierMagnitude(XPSetByCaller);
+	InfoXP.ModifierOp = EGameplayModOp::Additive;
+	InfoXP.Attribute = UGSAttributeSetBase::GetXPAttribute();
+
+	FSetByCallerFloat GoldSetByCaller;
+	GoldSetByCaller.DataTag = FGameplayTag::RequestGameplayTag("Data.Bounty.Gold");
+
+	FGameplayModifierInfo& InfoGold = Modifiers.AddDefaulted_GetRef();
+	InfoGold.ModifierMagnitude = FGameplayEffectModifierMagnitude(GoldSetByCaller);
+	InfoGold.ModifierOp = EGameplayModOp::Additive;
+	InfoGold.Attribute = UGSAttributeSetBase::GetGoldAttribute();
+}
@@ -2,8 +2,253 @@
 
 
 #include "Characters/Abilities/GSGameplayEffectTypes.h"
+#include "Engine/NetSerialization.h"
+#include "UObject/CoreNet.h"
+
+#if !UE_BUILD_SHIPPING
+static TAutoConsoleVariable<int32> CVarMeasureEffectContextNetSerialize(
+	TEXT("GS.EffectContext.MeasureNetSerialize"),
+	0,
+	TEXT("Log the bytes each replicated GSGameplayEffectContext takes with the default and compact TargetData serialization")
+);
+#endif
+
+// Most TargetData that we will send in one context. Matches FGameplayAbilityTargetDataHandle.
+static const uint32 MaxNetTargetData = 255;
+
+// Bones that we can hit on the hero physics assets. These are sent as an index instead of an FName.
+static const FName NetBoneNames[] =
+{
+	FName("b_Root"), FName("b_Hips"), FName("b_Spine"), FName("b_Spine1"), FName("b_Neck"), FName("b_head"),
+	FName("b_LeftShoulder"), FName("b_LeftArm"), FName("b_LeftArmRoll"), FName("b_LeftForeArm"), FName("b_LeftForeArmRoll"), FName("b_LeftHand"),
+	FName("b_RightShoulder"), FName("b_RightArm"), FName("b_RightArmRoll"), FName("b_RightForeArm"), FName("b_RightForeArmRoll"), FName("b_RightHand"),
+	FName("b_LeftUpLeg"), FName("b_LeftLeg"), FName("b_LeftFoot"), FName("b_LeftToeBase"),
+	FName("b_RightUpLeg"), FName("b_RightLeg"), FName("b_RightFoot"), FName("b_RightToeBase")
+};
+
+// Index that means the bone isn't in NetBoneNames and the FName follows. Bone indices are sent in 5 bits.
+static const uint32 NetBoneNameEscapeIndex = 31;
+
+static_assert(UE_ARRAY_COUNT(NetBoneNames) < NetBoneNameEscapeIndex, "NetBoneNames doesn't fit in 5 bits");
+
+enum class EGSNetHitFlags : uint8
+{
+	BlockingHit			= 1 << 0,
+	StartPenetrating	= 1 << 1,
+	ImpactPoint			= 1 << 2,	// ImpactPoint differs from Location
+	ImpactNormal		= 1 << 3,	// ImpactNormal differs from Normal
+	Trace				= 1 << 4,
+	BoneName			= 1 << 5,
+	PhysMaterial		= 1 << 6
+};
+
+static const uint32 NumNetHitFlagBits = 7;
 
 bool FGSGameplayEffectContext::NetSerialize(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
 {
-	return Super::NetSerialize(Ar, Map, bOutSuccess) && TargetData.NetSerialize(Ar, Map, bOutSuccess);
+#if !UE_BUILD_SHIPPING
+	if (Ar.IsSaving() && CVarMeasureEffectContextNetSerialize.GetValueOnAnyThread() > 0)
+	{
+		MeasureNetSerialize(Map);
+	}
+#endif
+
+	return Super::NetSerialize(Ar, Map, bOutSuccess) && NetSerializeTargetData(Ar, Map, bOutSuccess);
+}
+
+bool FGSGameplayEffectContext::NetSerializeTargetData(FArchive& Ar, UPackageMap* Map, bool& bOutSuccess)
+{
+	const UScriptStruct* SingleTargetHitStruct = FGameplayAbilityTargetData_SingleTargetHit::StaticStruct();
+
+	TArray<TSharedPtr<FGameplayAbilityTargetData>, TInlineAllocator<8>> ValidData;
+	if (Ar.IsSaving())
+	{
+		for (const TSharedPtr<FGameplayAbilityTargetData>& Data : TargetData.Data)
+		{
+			if (Data.IsValid() && ValidData.Num() < (int32)MaxNetTargetData)
+			{
+				ValidData.Add(Data);
+			}
+		}
+	}
+
+	uint32 NumData = ValidData.Num();
+	Ar.SerializeIntPacked(NumData);
+
+	if (Ar.IsLoading())
+	{
+		if (NumData > MaxNetTargetData)
+		{
+			Ar.SetError();
+			bOutSuccess = false;
+			return false;
+		}
+
+		ValidData.SetNum(NumData);
+	}
+
+	// Everything that isn't a single hit is sent after the hits with the default serialization
+	FGameplayAbilityTargetDataHandle OtherTargetData;
+
+	for (uint32 DataIndex = 0; DataIndex < NumData; DataIndex++)
+	{
+		uint8 bIsSingleTargetHit = Ar.IsSaving() && ValidData[DataIndex]->GetScriptStruct() == SingleTargetHitStruct;
+		Ar.SerializeBits(&bIsSingleTargetHit, 1);
+
+		if (bIsSingleTargetHit)
+		{
+			if (Ar.IsSaving())
+			{
+				FHitResult HitResult = *ValidData[DataIndex]->GetHitResult();
+				NetSerializeHitResult(Ar, HitResult);
+			}
+			else
+			{
+				FHitResult HitResult;
+				NetSerializeHitResult(Ar, HitResult);
+				ValidData[DataIndex] = MakeShareable(new FGameplayAbilityTargetData_SingleTargetHit(HitResult));
+			}
+		}
+		else if (Ar.IsSaving())
+		{
+			OtherTargetData.Data.Add(ValidData[DataIndex]);
+		}
+	}
+
+	uint8 bHasOtherTargetData = OtherTargetData.Num() > 0;
+	Ar.SerializeBits(&bHasOtherTargetData, 1);
+
+	if (bHasOtherTargetData && !OtherTargetData.NetSerialize(Ar, Map, bOutSuccess))
+	{
+		return false;
+	}
+
+	if (Ar.IsLoading())
+	{
+		// Put the other TargetData back in the slots they were sent from
+		int32 OtherIndex = 0;
+		for (TSharedPtr<FGameplayAbilityTargetData>& Data : ValidData)
+		{
+			if (!Data.IsValid() && OtherTargetData.Data.IsValidIndex(OtherIndex))
+			{
+				Data = OtherTargetData.Data[OtherIndex++];
+			}
+		}
+
+		TargetData.Clear();
+		TargetData.Data.Append(ValidData);
+	}
+
+	bOutSuccess = !Ar.IsError();
+	return bOutSuccess;
+}
+
+void FGSGameplayEffectContext::NetSerializeHitResult(FArchive& Ar, FHitResult& HitResult)
+{
+	uint32 BoneNameIndex = NetBoneNameEscapeIndex;
+	uint8 Flags = 0;
+
+	if (Ar.IsSaving())
+	{
+		Flags |= HitResult.bBlockingHit ? (uint8)EGSNetHitFlags::BlockingHit : 0;
+		Flags |= HitResult.bStartPenetrating ? (uint8)EGSNetHitFlags::StartPenetrating : 0;
+		Flags |= !HitResult.ImpactPoint.Equals(HitResult.Location, 1.0f) ? (uint8)EGSNetHitFlags::ImpactPoint : 0;
+		Flags |= !HitResult.ImpactNormal.Equals(HitResult.Normal, 0.01f) ? (uint8)EGSNetHitFlags::ImpactNormal : 0;
+		Flags |= !HitResult.TraceStart.IsZero() || !HitResult.TraceEnd.IsZero() ? (uint8)EGSNetHitFlags::Trace : 0;
+		Flags |= HitResult.BoneName != NAME_None ? (uint8)EGSNetHitFlags::BoneName : 0;
+		Flags |= HitResult.PhysMaterial.IsValid() ? (uint8)EGSNetHitFlags::PhysMaterial : 0;
+	}
+
+	Ar.SerializeBits(&Flags, NumNetHitFlagBits);
+
+	HitResult.bBlockingHit = (Flags & (uint8)EGSNetHitFlags::BlockingHit) != 0;
+	HitResult.bStartPenetrating = (Flags & (uint8)EGSNetHitFlags::StartPenetrating) != 0;
+
+	// 1cm precision for positions, hits only need to be close enough for effects and damage
+	SerializePackedVector<1, 20>(HitResult.Location, Ar);
+	SerializeFixedVector<1, 8>(HitResult.Normal, Ar);
+
+	if (Flags & (uint8)EGSNetHitFlags::ImpactPoint)
+	{
+		SerializePackedVector<1, 20>(HitResult.ImpactPoint, Ar);
+	}
+	else
+	{
+		HitResult.ImpactPoint = HitResult.Location;
+	}
+
+	if (Flags & (uint8)EGSNetHitFlags::ImpactNormal)
+	{
+		SerializeFixedVector<1, 8>(HitResult.ImpactNormal, Ar);
+	}
+	else
+	{
+		HitResult.ImpactNormal = HitResult.Normal;
+	}
+
+	if (Flags & (uint8)EGSNetHitFlags::Trace)
+	{
+		SerializePackedVector<1, 20>(HitResult.TraceStart, Ar);
+		SerializePackedVector<1, 20>(HitResult.TraceEnd, Ar);
+
+		if (Ar.IsLoading())
+		{
+			// Derived instead of sent
+			HitResult.Distance = FVector::Dist(HitResult.TraceStart, HitResult.Location);
+			const float TraceLength = FVector::Dist(HitResult.TraceStart, HitResult.TraceEnd);
+			HitResult.Time = TraceLength > KINDA_SMALL_NUMBER ? HitResult.Distance / TraceLength : 1.0f;
+		}
+	}
+
+	Ar << HitResult.Actor;
+	Ar << HitResult.Component;
+
+	if (Flags & (uint8)EGSNetHitFlags::PhysMaterial)
+	{
+		Ar << HitResult.PhysMaterial;
+	}
+
+	if (Flags & (uint8)EGSNetHitFlags::BoneName)
+	{
+		if (Ar.IsSaving())
+		{
+			for (uint32 Index = 0; Index < UE_ARRAY_COUNT(NetBoneNames); Index++)
+			{
+				if (NetBoneNames[Index] == HitResult.BoneName)
+				{
+					BoneNameIndex = Index;
+					break;
+				}
+			}
+		}
+
+		Ar.SerializeInt(BoneNameIndex, NetBoneNameEscapeIndex + 1);
+
+		if (BoneNameIndex == NetBoneNameEscapeIndex)
+		{
+			Ar << HitResult.BoneName;
+		}
+		else if (Ar.IsLoading())
+		{
+			HitResult.BoneName = BoneNameIndex < UE_ARRAY_COUNT(NetBoneNames) ? NetBoneNames[BoneNameIndex] : NAME_None;
+		}
+	}
+}
+
+#if !UE_BUILD_SHIPPING
+void FGSGameplayEffectContext::MeasureNetSerialize(UPackageMap* Map)
+{
+	bool bSuccess = true;
+
+	FNetBitWriter DefaultWriter(Map, 0);
+	FGameplayEffectContext::NetSerialize(DefaultWriter, Map, bSuccess);
+	TargetData.NetSerialize(DefaultWriter, Map, bSuccess);
+
+	FNetBitWriter CompactWriter(Map, 0);
+	FGameplayEffectContext::NetSerialize(CompactWriter, Map, bSuccess);
+	NetSerializeTargetData(CompactWriter, Map, bSuccess);
+
+	UE_LOG(LogTemp, Log, TEXT("%s TargetData: %d Default: %d bytes Compact: %d bytes"), *FString(__FUNCTION__), TargetData.Num(),
+		(int32)DefaultWriter.GetNumBytes(), (int32)CompactWriter.GetNumBytes());
 }
+#endif
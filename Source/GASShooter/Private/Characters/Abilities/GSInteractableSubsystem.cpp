@@ -0,0 +1,193 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Characters/Abilities/GSInteractableSubsystem.h"
+#include "Characters/Abilities/GSInteractable.h"
+#include "Engine/Level.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+
+UGSInteractableSubsystem::UGSInteractableSubsystem()
+{
+	CellSize = 1000.0f;
+	bIndexBuilt = false;
+	AvailabilityVersion = 0;
+}
+
+void UGSInteractableSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+
+	ActorSpawnedDelegateHandle = GetWorld()->AddOnActorSpawnedHandler(FOnActorSpawned::FDelegate::CreateUObject(this, &UGSInteractableSubsystem::OnActorSpawned));
+	LevelAddedDelegateHandle = FWorldDelegates::LevelAddedToWorld.AddUObject(this, &UGSInteractableSubsystem::OnLevelAddedToWorld);
+}
+
+void UGSInteractableSubsystem::Deinitialize()
+{
+	if (UWorld* World = GetWorld())
+	{
+		World->RemoveOnActorSpawnedHandler(ActorSpawnedDelegateHandle);
+	}
+
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedDelegateHandle);
+
+	StaticCells.Empty();
+	MovableInteractables.Empty();
+
+	Super::Deinitialize();
+}
+
+void UGSInteractableSubsystem::RegisterInteractable(AActor* Actor)
+{
+	if (!IsValid(Actor) || !Actor->Implements<UGSInteractable>() || !Actor->GetRootComponent())
+	{
+		return;
+	}
+
+	FVector BoundsOrigin;
+	FVector BoundsExtent;
+	Actor->GetActorBounds(false, BoundsOrigin, BoundsExtent);
+
+	FGSInteractableEntry Entry;
+	Entry.Actor = Actor;
+
+	if (Actor->GetRootComponent()->Mobility == EComponentMobility::Movable)
+	{
+		for (const FGSInteractableEntry& MovableEntry : MovableInteractables)
+		{
+			if (MovableEntry.Actor == Actor)
+			{
+				return;
+			}
+		}
+
+		// Relative to the Actor's location since we read it live when querying
+		Entry.Location = Actor->GetActorLocation();
+		Entry.BoundsRadius = BoundsExtent.Size() + FVector::Dist(BoundsOrigin, Entry.Location);
+		MovableInteractables.Add(Entry);
+		return;
+	}
+
+	Entry.Location = BoundsOrigin;
+	Entry.BoundsRadius = BoundsExtent.Size();
+
+	// Add to every cell that the bounds touch so that queries only need to look at the cells their range touches
+	const FIntVector MinCell = GetCell(Entry.Location - FVector(Entry.BoundsRadius));
+	const FIntVector MaxCell = GetCell(Entry.Location + FVector(Entry.BoundsRadius));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				TArray<FGSInteractableEntry>& Cell = StaticCells.FindOrAdd(FIntVector(X, Y, Z));
+				if (!Cell.ContainsByPredicate([Actor](const FGSInteractableEntry& CellEntry) { return CellEntry.Actor == Actor; }))
+				{
+					Cell.Add(Entry);
+				}
+			}
+		}
+	}
+}
+
+void UGSInteractableSubsystem::NotifyAvailabilityChanged(AActor* Actor)
+{
+	AvailabilityVersion++;
+}
+
+bool UGSInteractableSubsystem::HasInteractableInRange(const FVector& Location, float Range, const AActor* IgnoreActor)
+{
+	if (!bIndexBuilt)
+	{
+		BuildIndex();
+	}
+
+	for (int32 i = MovableInteractables.Num() - 1; i >= 0; i--)
+	{
+		const AActor* Actor = MovableInteractables[i].Actor.Get();
+		if (!Actor)
+		{
+			MovableInteractables.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (Actor != IgnoreActor && FVector::Dist(Location, Actor->GetActorLocation()) <= Range + MovableInteractables[i].BoundsRadius)
+		{
+			return true;
+		}
+	}
+
+	const FIntVector MinCell = GetCell(Location - FVector(Range));
+	const FIntVector MaxCell = GetCell(Location + FVector(Range));
+
+	for (int32 X = MinCell.X; X <= MaxCell.X; X++)
+	{
+		for (int32 Y = MinCell.Y; Y <= MaxCell.Y; Y++)
+		{
+			for (int32 Z = MinCell.Z; Z <= MaxCell.Z; Z++)
+			{
+				TArray<FGSInteractableEntry>* Cell = StaticCells.Find(FIntVector(X, Y, Z));
+				if (!Cell)
+				{
+					continue;
+				}
+
+				for (int32 i = Cell->Num() - 1; i >= 0; i--)
+				{
+					const FGSInteractableEntry& Entry = (*Cell)[i];
+					const AActor* Actor = Entry.Actor.Get();
+					if (!Actor)
+					{
+						Cell->RemoveAtSwap(i);
+						continue;
+					}
+
+					if (Actor != IgnoreActor && FVector::Dist(Location, Entry.Location) <= Range + Entry.BoundsRadius)
+					{
+						return true;
+					}
+				}
+			}
+		}
+	}
+
+	return false;
+}
+
+FIntVector UGSInteractableSubsystem::GetCell(const FVector& Location) const
+{
+	return FIntVector(FMath::FloorToInt(Location.X / CellSize), FMath::FloorToInt(Location.Y / CellSize), FMath::FloorToInt(Location.Z / CellSize));
+}
+
+void UGSInteractableSubsystem::BuildIndex()
+{
+	bIndexBuilt = true;
+
+	for (TActorIterator<AActor> It(GetWorld()); It; ++It)
+	{
+		RegisterInteractable(*It);
+	}
+}
+
+void UGSInteractableSubsystem::OnActorSpawned(AActor* Actor)
+{
+	// Anything spawned before the first query will be picked up by BuildIndex()
+	if (bIndexBuilt)
+	{
+		RegisterInteractable(Actor);
+	}
+}
+
+void UGSInteractableSubsystem::OnLevelAddedToWorld(ULevel* Level, UWorld* World)
+{
+	if (!bIndexBuilt || World != GetWorld() || !Level)
+	{
+		return;
+	}
+
+	for (AActor* Actor : Level->Actors)
+	{
+		RegisterInteractable(Actor);
+	}
+}
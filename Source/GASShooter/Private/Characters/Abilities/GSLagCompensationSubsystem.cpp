@@ -0,0 +1,225 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Characters/Abilities/GSLagCompensationSubsystem.h"
+#include "Characters/GSCharacterBase.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerState.h"
+
+static TAutoConsoleVariable<int32> CVarLagCompensationEnabled(
+	TEXT("GS.LagCompensation.Enabled"),
+	1,
+	TEXT("Verify client sent hit results against the target's hitbox history on the server. 0 accepts all client hits.")
+);
+
+static TAutoConsoleVariable<float> CVarLagCompensationTimeTolerance(
+	TEXT("GS.LagCompensation.TimeTolerance"),
+	0.1f,
+	TEXT("Seconds around the shooter's rewind time that a hit may match the target's hitbox in")
+);
+
+static TAutoConsoleVariable<float> CVarLagCompensationDistanceTolerance(
+	TEXT("GS.LagCompensation.DistanceTolerance"),
+	25.0f,
+	TEXT("Distance in cm outside of the target's historical capsule that a hit is still accepted")
+);
+
+void FGSHitboxHistory::Init(int32 Capacity, float InCapsuleRadius, float InCapsuleHalfHeight)
+{
+	Snapshots.SetNum(FMath::Max(Capacity, 1));
+	Head = 0;
+	Num = 0;
+	CapsuleRadius = InCapsuleRadius;
+	CapsuleHalfHeight = InCapsuleHalfHeight;
+}
+
+void FGSHitboxHistory::Record(float Time, const FVector& Location, const FQuat& Rotation)
+{
+	FGSHitboxSnapshot& Snapshot = Snapshots[Head];
+	Snapshot.Time = Time;
+	Snapshot.Location = Location;
+	Snapshot.Rotation = Rotation;
+
+	Head = (Head + 1) % Snapshots.Num();
+	Num = FMath::Min(Num + 1, Snapshots.Num());
+}
+
+const FGSHitboxSnapshot& FGSHitboxHistory::GetFromNewest(int32 Index) const
+{
+	check(Index >= 0 && Index < Num);
+	return Snapshots[(Head - 1 - Index + Snapshots.Num()) % Snapshots.Num()];
+}
+
+UGSLagCompensationSubsystem::UGSLagCompensationSubsystem()
+{
+	MaxRewindTime = 0.5f;
+	SampleInterval = 1.0f / 60.0f;
+	TimeSinceLastSample = 0.0f;
+}
+
+void UGSLagCompensationSubsystem::Deinitialize()
+{
+	Histories.Empty();
+
+	Super::Deinitialize();
+}
+
+void UGSLagCompensationSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceLastSample += DeltaTime;
+
+	if (TimeSinceLastSample >= SampleInterval)
+	{
+		TimeSinceLastSample = 0.0f;
+		RecordSnapshots();
+	}
+}
+
+bool UGSLagCompensationSubsystem::IsTickable() const
+{
+	// Only the server verifies hits
+	const UWorld* World = GetWorld();
+	return !HasAnyFlags(RF_ClassDefaultObject) && World && World->GetNetMode() != NM_Client && Histories.Num() > 0;
+}
+
+TStatId UGSLagCompensationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGSLagCompensationSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UGSLagCompensationSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UGSLagCompensationSubsystem::RegisterCharacter(AGSCharacterBase* Character)
+{
+	if (!IsValid(Character) || Character->GetLocalRole() != ROLE_Authority)
+	{
+		return;
+	}
+
+	const UCapsuleComponent* Capsule = Character->GetCapsuleComponent();
+
+	FGSHitboxHistory& History = Histories.FindOrAdd(Character);
+	History.Init(FMath::CeilToInt(MaxRewindTime / SampleInterval) + 1, Capsule->GetScaledCapsuleRadius(), Capsule->GetScaledCapsuleHalfHeight());
+	History.Record(GetWorld()->GetTimeSeconds(), Character->GetActorLocation(), Character->GetActorQuat());
+}
+
+void UGSLagCompensationSubsystem::UnregisterCharacter(AGSCharacterBase* Character)
+{
+	Histories.Remove(Character);
+}
+
+float UGSLagCompensationSubsystem::GetRewindTimeForShooter(const APlayerState* ShooterPlayerState) const
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	if (!ShooterPlayerState)
+	{
+		return Now;
+	}
+
+	// ExactPing is the round trip time in ms. The shooter saw the target half a trip ago and the shot took the other
+	// half to get here.
+	const float RewindSeconds = FMath::Min(ShooterPlayerState->ExactPing * 0.001f, MaxRewindTime);
+	return Now - RewindSeconds;
+}
+
+bool UGSLagCompensationSubsystem::IsHitValid(const FHitResult& HitResult, float RewindTime) const
+{
+	AGSCharacterBase* HitCharacter = Cast<AGSCharacterBase>(HitResult.Actor.Get());
+	if (!HitCharacter)
+	{
+		return true;
+	}
+
+	const FGSHitboxHistory* History = Histories.Find(HitCharacter);
+	if (!History || History->Num < 1)
+	{
+		return true;
+	}
+
+	const float TimeTolerance = CVarLagCompensationTimeTolerance.GetValueOnGameThread();
+	const float AcceptRadius = History->CapsuleRadius + CVarLagCompensationDistanceTolerance.GetValueOnGameThread();
+	const float AxisHalfLength = FMath::Max(History->CapsuleHalfHeight - History->CapsuleRadius, 0.0f);
+
+	// Clamp to the history we have so that very high ping shooters are checked against the oldest pose
+	const float OldestTime = History->GetFromNewest(History->Num - 1).Time;
+	const float NewestTime = History->GetFromNewest(0).Time;
+	const float ClampedRewindTime = FMath::Clamp(RewindTime, OldestTime, NewestTime);
+
+	for (int32 i = 0; i < History->Num; i++)
+	{
+		const FGSHitboxSnapshot& Snapshot = History->GetFromNewest(i);
+
+		if (Snapshot.Time > ClampedRewindTime + TimeTolerance)
+		{
+			continue;
+		}
+
+		if (Snapshot.Time < ClampedRewindTime - TimeTolerance)
+		{
+			// Snapshots only get older from here
+			break;
+		}
+
+		const FVector Axis = Snapshot.Rotation.GetUpVector() * AxisHalfLength;
+		const float Distance = FMath::PointDistToSegment(HitResult.ImpactPoint, Snapshot.Location - Axis, Snapshot.Location + Axis);
+		if (Distance <= AcceptRadius)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+int32 UGSLagCompensationSubsystem::ValidateTargetData(const FGameplayAbilityTargetDataHandle& InTargetData, const APlayerState* ShooterPlayerState, FGameplayAbilityTargetDataHandle& OutTargetData) const
+{
+	if (CVarLagCompensationEnabled.GetValueOnGameThread() == 0 || Histories.Num() < 1)
+	{
+		OutTargetData = InTargetData;
+		return 0;
+	}
+
+	const float RewindTime = GetRewindTimeForShooter(ShooterPlayerState);
+	int32 NumRejected = 0;
+
+	OutTargetData.Clear();
+	OutTargetData.Data.Reserve(InTargetData.Num());
+
+	for (const TSharedPtr<FGameplayAbilityTargetData>& TargetData : InTargetData.Data)
+	{
+		const FHitResult* HitResult = TargetData.IsValid() ? TargetData->GetHitResult() : nullptr;
+
+		if (HitResult && !IsHitValid(*HitResult, RewindTime))
+		{
+			NumRejected++;
+			continue;
+		}
+
+		// Shares the TargetData, no copy
+		OutTargetData.Data.Add(TargetData);
+	}
+
+	return NumRejected;
+}
+
+void UGSLagCompensationSubsystem::RecordSnapshots()
+{
+	const float Now = GetWorld()->GetTimeSeconds();
+
+	for (auto It = Histories.CreateIterator(); It; ++It)
+	{
+		AGSCharacterBase* Character = It.Key().Get();
+		if (!Character)
+		{
+			It.RemoveCurrent();
+			continue;
+		}
+
+		It.Value().Record(Now, Character->GetActorLocation(), Character->GetActorQuat());
+	}
+}
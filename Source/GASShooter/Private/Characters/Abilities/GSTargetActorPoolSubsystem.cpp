@@ -0,0 +1,133 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Characters/Abilities/GSTargetActorPoolSubsystem.h"
+#include "Abilities/GameplayAbility.h"
+#include "Characters/Abilities/GSGATA_Trace.h"
+#include "Engine/World.h"
+#include "GSStats.h"
+
+static FAutoConsoleCommandWithWorld DumpTargetActorPoolStatsCommand(
+	TEXT("GS.TargetActorPool.Stats"),
+	TEXT("Logs hits, misses, and high water marks for the trace TargetActor pool"),
+	FConsoleCommandWithWorldDelegate::CreateStatic([](UWorld* World)
+	{
+		if (const UGSTargetActorPoolSubsystem* Pool = World ? World->GetSubsystem<UGSTargetActorPoolSubsystem>() : nullptr)
+		{
+			Pool->DumpPoolStats();
+		}
+	})
+);
+
+void UGSTargetActorPoolSubsystem::Deinitialize()
+{
+	// The world is tearing down and will destroy the TargetActors
+	Buckets.Empty();
+
+	Super::Deinitialize();
+}
+
+AGSGATA_Trace* UGSTargetActorPoolSubsystem::LeaseTargetActor(TSubclassOf<AGSGATA_Trace> TargetActorClass, AActor* NewOwner)
+{
+	if (!TargetActorClass)
+	{
+		return nullptr;
+	}
+
+	FGSTargetActorPoolBucket& Bucket = Buckets.FindOrAdd(TargetActorClass);
+	FreePendingTargetActors(Bucket);
+
+	AGSGATA_Trace* TargetActor = nullptr;
+	while (!TargetActor && Bucket.FreeTargetActors.Num() > 0)
+	{
+		// Something else may have destroyed it while it was in the pool
+		TargetActor = Bucket.FreeTargetActors.Pop(false);
+		if (!IsValid(TargetActor))
+		{
+			TargetActor = nullptr;
+		}
+	}
+
+	if (TargetActor)
+	{
+		Bucket.Stats.Hits++;
+	}
+	else
+	{
+		TargetActor = GetWorld()->SpawnActor<AGSGATA_Trace>(TargetActorClass);
+		if (!TargetActor)
+		{
+			return nullptr;
+		}
+
+		Bucket.Stats.Misses++;
+		GS_COUNT_ALLOCATIONS(STAT_GSTraceTargetActorsSpawned, 1);
+	}
+
+	Bucket.Stats.NumLeased++;
+	Bucket.Stats.HighWaterMark = FMath::Max(Bucket.Stats.HighWaterMark, Bucket.Stats.NumLeased);
+
+	TargetActor->SetOwner(NewOwner);
+	return TargetActor;
+}
+
+void UGSTargetActorPoolSubsystem::ReturnTargetActor(AGSGATA_Trace* TargetActor)
+{
+	if (!IsValid(TargetActor))
+	{
+		return;
+	}
+
+	FGSTargetActorPoolBucket& Bucket = Buckets.FindOrAdd(TargetActor->GetClass());
+	Bucket.Stats.NumLeased = FMath::Max(Bucket.Stats.NumLeased - 1, 0);
+
+	// Resetting it now would pull it out from under the ability's targeting task
+	if (IsTargetActorInUse(TargetActor))
+	{
+		Bucket.PendingTargetActors.AddUnique(TargetActor);
+		return;
+	}
+
+	// Make sure no ability is still listening to it and drop any state and references from the last user
+	TargetActor->ResetForReuse();
+	Bucket.FreeTargetActors.AddUnique(TargetActor);
+}
+
+bool UGSTargetActorPoolSubsystem::IsTargetActorInUse(const AGSGATA_Trace* TargetActor)
+{
+	return TargetActor->OwningAbility && TargetActor->OwningAbility->IsActive();
+}
+
+void UGSTargetActorPoolSubsystem::FreePendingTargetActors(FGSTargetActorPoolBucket& Bucket)
+{
+	for (int32 i = Bucket.PendingTargetActors.Num() - 1; i >= 0; i--)
+	{
+		AGSGATA_Trace* TargetActor = Bucket.PendingTargetActors[i];
+		if (!IsValid(TargetActor))
+		{
+			Bucket.PendingTargetActors.RemoveAtSwap(i, 1, false);
+		}
+		else if (!IsTargetActorInUse(TargetActor))
+		{
+			Bucket.PendingTargetActors.RemoveAtSwap(i, 1, false);
+			TargetActor->ResetForReuse();
+			Bucket.FreeTargetActors.AddUnique(TargetActor);
+		}
+	}
+}
+
+FGSTargetActorPoolStats UGSTargetActorPoolSubsystem::GetPoolStats(TSubclassOf<AGSGATA_Trace> TargetActorClass) const
+{
+	const FGSTargetActorPoolBucket* Bucket = Buckets.Find(TargetActorClass);
+	return Bucket ? Bucket->Stats : FGSTargetActorPoolStats();
+}
+
+void UGSTargetActorPoolSubsystem::DumpPoolStats() const
+{
+	for (const TPair<UClass*, FGSTargetActorPoolBucket>& Pair : Buckets)
+	{
+		const FGSTargetActorPoolStats& Stats = Pair.Value.Stats;
+		UE_LOG(LogTemp, Log, TEXT("%s %s Hits: %d Misses: %d Leased: %d Free: %d Pending: %d HighWaterMark: %d"), *FString(__FUNCTION__), *GetNameSafe(Pair.Key),
+			Stats.Hits, Stats.Misses, Stats.NumLeased, Pair.Value.FreeTargetActors.Num(), Pair.Value.PendingTargetActors.Num(), Stats.HighWaterMark);
+	}
+}
@@ -6,8 +6,10 @@
 #include "Characters/Abilities/GSAbilitySystemComponent.h"
 #include "Characters/Abilities/GSAbilitySystemGlobals.h"
 #include "Characters/Abilities/GSGameplayAbility.h"
+#include "Characters/Abilities/GSLagCompensationSubsystem.h"
 #include "Characters/GSCharacterMovementComponent.h"
 #include "Components/CapsuleComponent.h"
+#include "GSStats.h"
 #include "Kismet/GameplayStatics.h"
 #include "Sound/SoundCue.h"
 #include "UI/GSDamageTextWidgetComponent.h"
@@ -27,6 +29,8 @@ AGSCharacterBase::AGSCharacterBase(const class FObjectInitializer& ObjectInitial
 	DeadTag = FGameplayTag::RequestGameplayTag("State.Dead");
 	EffectRemoveOnDeathTag = FGameplayTag::RequestGameplayTag("Effect.RemoveOnDeath");
 
+	MaxPooledDamageNumbers = 8;
+
 	// Hardcoding to avoid having to manually set for every Blueprint child class
 	DamageNumberClass = StaticLoadClass(UObject::StaticClass(), nullptr, TEXT("/Game/GASShooter/UI/WC_DamageText.WC_DamageText_C"));
 	if (!DamageNumberClass)
@@ -130,6 +134,24 @@ void AGSCharacterBase::AddDamageNumber(float Damage, FGameplayTagContainer Damag
 	}
 }
 
+void AGSCharacterBase::ReleaseDamageNumber(UGSDamageTextWidgetComponent* DamageText)
+{
+	if (!IsValid(DamageText))
+	{
+		return;
+	}
+
+	if (DamageNumberPool.Num() >= MaxPooledDamageNumbers || IsActorBeingDestroyed())
+	{
+		DamageText->bReturnToPoolOnDestroy = false;
+		DamageText->DestroyComponent();
+		return;
+	}
+
+	DamageText->ReleaseToPool();
+	DamageNumberPool.Add(DamageText);
+}
+
 int32 AGSCharacterBase::GetCharacterLevel() const
 {
 	//TODO
@@ -240,6 +262,24 @@ float AGSCharacterBase::GetMoveSpeedBaseValue() const
 void AGSCharacterBase::BeginPlay()
 {
 	Super::BeginPlay();
+
+	if (GetLocalRole() == ROLE_Authority)
+	{
+		if (UGSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UGSLagCompensationSubsystem>())
+		{
+			LagCompensation->RegisterCharacter(this);
+		}
+	}
+}
+
+void AGSCharacterBase::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (UGSLagCompensationSubsystem* LagCompensation = GetWorld()->GetSubsystem<UGSLagCompensationSubsystem>())
+	{
+		LagCompensation->UnregisterCharacter(this);
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 void AGSCharacterBase::AddCharacterAbilities()
@@ -309,18 +349,46 @@ void AGSCharacterBase::ShowDamageNumber()
 {
 	if (DamageNumberQueue.Num() > 0 && IsValid(this))
 	{
-		UGSDamageTextWidgetComponent* DamageText = NewObject<UGSDamageTextWidgetComponent>(this, DamageNumberClass);
-		DamageText->RegisterComponent();
-		DamageText->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
-		DamageText->SetDamageText(DamageNumberQueue[0].DamageAmount, DamageNumberQueue[0].Tags);
-
-		if (DamageNumberQueue.Num() < 1)
+		UGSDamageTextWidgetComponent* DamageText = AcquireDamageNumber();
+		if (DamageText)
 		{
-			GetWorldTimerManager().ClearTimer(DamageNumberTimer);
+			DamageText->SetDamageText(DamageNumberQueue[0].DamageAmount, DamageNumberQueue[0].Tags);
 		}
 
 		DamageNumberQueue.RemoveAt(0);
 	}
+
+	if (DamageNumberQueue.Num() < 1)
+	{
+		GetWorldTimerManager().ClearTimer(DamageNumberTimer);
+	}
+}
+
+UGSDamageTextWidgetComponent* AGSCharacterBase::AcquireDamageNumber()
+{
+	while (DamageNumberPool.Num() > 0)
+	{
+		UGSDamageTextWidgetComponent* DamageText = DamageNumberPool.Pop(false);
+		if (IsValid(DamageText))
+		{
+			DamageText->ResetForReuse();
+			DamageText->SetComponentTickEnabled(true);
+			DamageText->SetVisibility(true, true);
+			return DamageText;
+		}
+	}
+
+	if (!DamageNumberClass)
+	{
+		return nullptr;
+	}
+
+	GS_COUNT_ALLOCATIONS(STAT_GSHUDDamageNumberWidgetsCreated, 1);
+	UGSDamageTextWidgetComponent* DamageText = NewObject<UGSDamageTextWidgetComponent>(this, DamageNumberClass);
+	DamageText->bReturnToPoolOnDestroy = true;
+	DamageText->RegisterComponent();
+	DamageText->AttachToComponent(GetRootComponent(), FAttachmentTransformRules::KeepRelativeTransform);
+	return DamageText;
 }
 
 void AGSCharacterBase::SetHealth(float Health)
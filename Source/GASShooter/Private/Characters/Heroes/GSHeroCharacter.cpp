@@ -7,12 +7,15 @@
 #include "Camera/CameraComponent.h"
 #include "Characters/Abilities/GSAbilitySystemComponent.h"
 #include "Characters/Abilities/GSAbilitySystemGlobals.h"
+#include "Characters/Abilities/GSGE_AmmoGrant.h"
+#include "Characters/Abilities/GSInteractableSubsystem.h"
 #include "Characters/Abilities/AttributeSets/GSAmmoAttributeSet.h"
 #include "Characters/Abilities/AttributeSets/GSAttributeSetBase.h"
 #include "Components/WidgetComponent.h"
 #include "GameFramework/SpringArmComponent.h"
 #include "GASShooter/GASShooterGameModeBase.h"
 #include "GSBlueprintFunctionLibrary.h"
+#include "GSStats.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Net/UnrealNetwork.h"
@@ -20,9 +23,119 @@
 #include "Player/GSPlayerState.h"
 #include "Sound/SoundCue.h"
 #include "TimerManager.h"
+#include "UI/GSFloatingStatusBarSubsystem.h"
 #include "UI/GSFloatingStatusBarWidget.h"
 #include "Weapons/GSWeapon.h"
 
+void FGSHeroInventoryWeapon::PreReplicatedRemove(const FGSHeroInventory& InArraySerializer)
+{
+	const_cast<FGSHeroInventory&>(InArraySerializer).UnIndexWeapon(*this);
+}
+
+void FGSHeroInventoryWeapon::PostReplicatedAdd(const FGSHeroInventory& InArraySerializer)
+{
+	const_cast<FGSHeroInventory&>(InArraySerializer).IndexWeapon(*this);
+}
+
+void FGSHeroInventoryWeapon::PostReplicatedChange(const FGSHeroInventory& InArraySerializer)
+{
+	// The Weapon may not have been replicated yet when the slot was added, or the slot may now hold a different Weapon
+	const_cast<FGSHeroInventory&>(InArraySerializer).IndexWeapon(*this);
+}
+
+int32 FGSHeroInventory::IndexOfWeapon(const AGSWeapon* InWeapon) const
+{
+	return Weapons.IndexOfByPredicate([InWeapon](const FGSHeroInventoryWeapon& Entry) { return Entry.Weapon == InWeapon; });
+}
+
+bool FGSHeroInventory::ContainsWeaponClass(const UClass* WeaponClass) const
+{
+	const TWeakObjectPtr<AGSWeapon>* Weapon = WeaponsByClass.Find(WeaponClass);
+	if (!Weapon)
+	{
+		return false;
+	}
+
+	if (IsValid(Weapon->Get()))
+	{
+		return true;
+	}
+
+	// The indexed Weapon was destroyed before its slot was removed. Another slot may still hold the same class.
+	return Weapons.ContainsByPredicate([WeaponClass](const FGSHeroInventoryWeapon& Entry) { return IsValid(Entry.Weapon) && Entry.Weapon->GetClass() == WeaponClass; });
+}
+
+void FGSHeroInventory::AddWeapon(AGSWeapon* InWeapon)
+{
+	FGSHeroInventoryWeapon& Entry = Weapons.Add_GetRef(FGSHeroInventoryWeapon(InWeapon));
+	IndexWeapon(Entry);
+	MarkItemDirty(Entry);
+}
+
+bool FGSHeroInventory::RemoveWeapon(AGSWeapon* InWeapon)
+{
+	const int32 Index = IndexOfWeapon(InWeapon);
+	if (Index == INDEX_NONE)
+	{
+		return false;
+	}
+
+	UnIndexWeapon(Weapons[Index]);
+	Weapons.RemoveAt(Index);
+	MarkArrayDirty();
+	return true;
+}
+
+void FGSHeroInventory::IndexWeapon(FGSHeroInventoryWeapon& Entry)
+{
+	if (Entry.Weapon && Entry.IndexedWeapon.Get() == Entry.Weapon)
+	{
+		return;
+	}
+
+	UnIndexWeapon(Entry);
+
+	if (Entry.Weapon)
+	{
+		WeaponsByClass.Add(Entry.Weapon->GetClass(), Entry.Weapon);
+		Entry.IndexedWeapon = Entry.Weapon;
+		Entry.IndexedClass = Entry.Weapon->GetClass();
+	}
+}
+
+void FGSHeroInventory::UnIndexWeapon(FGSHeroInventoryWeapon& Entry)
+{
+	const UClass* IndexedClass = Entry.IndexedClass;
+	const TWeakObjectPtr<AGSWeapon> IndexedWeapon = Entry.IndexedWeapon;
+
+	Entry.IndexedClass = nullptr;
+	Entry.IndexedWeapon.Reset();
+
+	if (!IndexedClass)
+	{
+		return;
+	}
+
+	// The class may be indexed to another slot's Weapon, leave that one alone
+	TWeakObjectPtr<AGSWeapon>* ClassWeapon = WeaponsByClass.Find(IndexedClass);
+	if (!ClassWeapon || (*ClassWeapon != IndexedWeapon && ClassWeapon->IsValid()))
+	{
+		return;
+	}
+
+	WeaponsByClass.Remove(IndexedClass);
+
+	// Another slot may still hold the same class
+	for (const FGSHeroInventoryWeapon& Other : Weapons)
+	{
+		if (&Other != &Entry && IsValid(Other.Weapon) && Other.Weapon->GetClass() == IndexedClass)
+		{
+			WeaponsByClass.Add(IndexedClass, Other.Weapon);
+			break;
+		}
+	}
+}
+
 AGSHeroCharacter::AGSHeroCharacter(const class FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	BaseTurnRate = 45.0f;
@@ -137,6 +250,8 @@ void AGSHeroCharacter::PossessedBy(AController* NewController)
 		WeaponChangingDelayReplicationTagChangedDelegateHandle = AbilitySystemComponent->RegisterGameplayTagEvent(WeaponChangingDelayReplicationTag)
 			.AddUObject(this, &AGSHeroCharacter::WeaponChangingDelayReplicationTagChanged);
 
+		BindInteractionAvailabilityTags();
+
 		// Set the AttributeSetBase for convenience attribute functions
 		AttributeSetBase = PS->GetAttributeSetBase();
 
@@ -170,10 +285,13 @@ void AGSHeroCharacter::PossessedBy(AController* NewController)
 
 		InitializeFloatingStatusBar();
 
-		// If player is host on listen server, the floating status bar would have been created for them from BeginPlay before player possession, hide it
-		if (IsLocallyControlled() && IsPlayerControlled() && UIFloatingStatusBarComponent && UIFloatingStatusBar)
+		// If player is host on listen server, the floating status bar would have been created for them from BeginPlay before player possession, remove it
+		if (IsLocallyControlled() && IsPlayerControlled())
 		{
-			UIFloatingStatusBarComponent->SetVisibility(false, true);
+			if (UGSFloatingStatusBarSubsystem* StatusBars = GetWorld()->GetSubsystem<UGSFloatingStatusBarSubsystem>())
+			{
+				StatusBars->UnregisterStatusBar(this);
+			}
 		}
 	}
 
@@ -182,7 +300,8 @@ void AGSHeroCharacter::PossessedBy(AController* NewController)
 
 UGSFloatingStatusBarWidget* AGSHeroCharacter::GetFloatingStatusBar()
 {
-	return UIFloatingStatusBar;
+	UGSFloatingStatusBarSubsystem* StatusBars = GetWorld() ? GetWorld()->GetSubsystem<UGSFloatingStatusBarSubsystem>() : nullptr;
+	return StatusBars ? StatusBars->GetStatusBarWidget(this) : nullptr;
 }
 
 void AGSHeroCharacter::KnockDown()
@@ -303,6 +422,8 @@ AGSWeapon* AGSHeroCharacter::GetCurrentWeapon() const
 
 bool AGSHeroCharacter::AddWeaponToInventory(AGSWeapon* NewWeapon, bool bEquipWeapon)
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSInventoryAddWeapon);
+
 	if (DoesWeaponExistInInventory(NewWeapon))
 	{
 		USoundCue* PickupSound = NewWeapon->GetPickupSound();
@@ -317,35 +438,35 @@ bool AGSHeroCharacter::AddWeaponToInventory(AGSWeapon* NewWeapon, bool bEquipWea
 			return false;
 		}
 
-		// Create a dynamic instant Gameplay Effect to give the primary and secondary ammo
-		UGameplayEffect* GEAmmo = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("Ammo")));
-		GEAmmo->DurationPolicy = EGameplayEffectDurationType::Instant;
-
-		if (NewWeapon->PrimaryAmmoType != WeaponAmmoTypeNoneTag)
+		// Give the primary and secondary ammo with the prebuilt ammo Gameplay Effect
+		FGameplayEffectSpec* AmmoSpec = AbilitySystemComponent->GetReusableOutgoingSpec(UGSAbilitySystemGlobals::GSGet().AmmoGrantEffect);
+		if (AmmoSpec)
 		{
-			int32 Idx = GEAmmo->Modifiers.Num();
-			GEAmmo->Modifiers.SetNum(Idx + 1);
+			for (const FGSAmmoTypeAttributes& AmmoType : UGSAmmoAttributeSet::GetAmmoTypes())
+			{
+				AmmoSpec->SetSetByCallerMagnitude(AmmoType.AmmoTag, 0.0f);
+			}
 
-			FGameplayModifierInfo& InfoPrimaryAmmo = GEAmmo->Modifiers[Idx];
-			InfoPrimaryAmmo.ModifierMagnitude = FScalableFloat(NewWeapon->GetPrimaryClipAmmo());
-			InfoPrimaryAmmo.ModifierOp = EGameplayModOp::Additive;
-			InfoPrimaryAmmo.Attribute = UGSAmmoAttributeSet::GetReserveAmmoAttributeFromTag(NewWeapon->PrimaryAmmoType);
-		}
+			bool bGrantsAmmo = false;
 
-		if (NewWeapon->SecondaryAmmoType != WeaponAmmoTypeNoneTag)
-		{
-			int32 Idx = GEAmmo->Modifiers.Num();
-			GEAmmo->Modifiers.SetNum(Idx + 1);
+			if (NewWeapon->PrimaryAmmoType != WeaponAmmoTypeNoneTag)
+			{
+				AmmoSpec->SetSetByCallerMagnitude(NewWeapon->PrimaryAmmoType, NewWeapon->GetPrimaryClipAmmo());
+				bGrantsAmmo = true;
+			}
 
-			FGameplayModifierInfo& InfoSecondaryAmmo = GEAmmo->Modifiers[Idx];
-			InfoSecondaryAmmo.ModifierMagnitude = FScalableFloat(NewWeapon->GetSecondaryClipAmmo());
-			InfoSecondaryAmmo.ModifierOp = EGameplayModOp::Additive;
-			InfoSecondaryAmmo.Attribute = UGSAmmoAttributeSet::GetReserveAmmoAttributeFromTag(NewWeapon->SecondaryAmmoType);
-		}
+			if (NewWeapon->SecondaryAmmoType != WeaponAmmoTypeNoneTag)
+			{
+				// Primary and secondary can share an ammo type
+				const float CurrentAmmo = AmmoSpec->GetSetByCallerMagnitude(NewWeapon->SecondaryAmmoType, false, 0.0f);
+				AmmoSpec->SetSetByCallerMagnitude(NewWeapon->SecondaryAmmoType, CurrentAmmo + NewWeapon->GetSecondaryClipAmmo());
+				bGrantsAmmo = true;
+			}
 
-		if (GEAmmo->Modifiers.Num() > 0)
-		{
-			AbilitySystemComponent->ApplyGameplayEffectToSelf(GEAmmo, 1.0f, AbilitySystemComponent->MakeEffectContext());
+			if (bGrantsAmmo)
+			{
+				AbilitySystemComponent->ApplyGameplayEffectSpecToSelf(*AmmoSpec);
+			}
 		}
 
 		NewWeapon->Destroy();
@@ -358,7 +479,7 @@ bool AGSHeroCharacter::AddWeaponToInventory(AGSWeapon* NewWeapon, bool bEquipWea
 		return false;
 	}
 
-	Inventory.Weapons.Add(NewWeapon);
+	Inventory.AddWeapon(NewWeapon);
 	NewWeapon->SetOwningCharacter(this);
 	NewWeapon->AddAbilities();
 
@@ -373,6 +494,8 @@ bool AGSHeroCharacter::AddWeaponToInventory(AGSWeapon* NewWeapon, bool bEquipWea
 
 bool AGSHeroCharacter::RemoveWeaponFromInventory(AGSWeapon* WeaponToRemove)
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSInventoryRemoveWeapon);
+
 	if (DoesWeaponExistInInventory(WeaponToRemove))
 	{
 		if (WeaponToRemove == CurrentWeapon)
@@ -380,7 +503,7 @@ bool AGSHeroCharacter::RemoveWeaponFromInventory(AGSWeapon* WeaponToRemove)
 			UnEquipCurrentWeapon();
 		}
 
-		Inventory.Weapons.Remove(WeaponToRemove);
+		Inventory.RemoveWeapon(WeaponToRemove);
 		WeaponToRemove->RemoveAbilities();
 		WeaponToRemove->SetOwningCharacter(nullptr);
 		WeaponToRemove->ResetWeapon();
@@ -403,11 +526,11 @@ void AGSHeroCharacter::RemoveAllWeaponsFromInventory()
 	UnEquipCurrentWeapon();
 
 	float radius = 50.0f;
-	float NumWeapons = Inventory.Weapons.Num();
+	float NumWeapons = Inventory.Num();
 
-	for (int32 i = Inventory.Weapons.Num() - 1; i >= 0; i--)
+	for (int32 i = Inventory.Num() - 1; i >= 0; i--)
 	{
-		AGSWeapon* Weapon = Inventory.Weapons[i];
+		AGSWeapon* Weapon = Inventory.GetWeapon(i);
 		RemoveWeaponFromInventory(Weapon);
 
 		// Set the weapon up as a pickup
@@ -420,6 +543,8 @@ void AGSHeroCharacter::RemoveAllWeaponsFromInventory()
 
 void AGSHeroCharacter::EquipWeapon(AGSWeapon* NewWeapon)
 {
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSInventoryEquipWeapon);
+
 	if (GetLocalRole() < ROLE_Authority)
 	{
 		ServerEquipWeapon(NewWeapon);
@@ -444,43 +569,43 @@ bool AGSHeroCharacter::ServerEquipWeapon_Validate(AGSWeapon* NewWeapon)
 
 void AGSHeroCharacter::NextWeapon()
 {
-	if (Inventory.Weapons.Num() < 2)
+	if (Inventory.Num() < 2)
 	{
 		return;
 	}
 
-	int32 CurrentWeaponIndex = Inventory.Weapons.Find(CurrentWeapon);
+	int32 CurrentWeaponIndex = Inventory.IndexOfWeapon(CurrentWeapon);
 	UnEquipCurrentWeapon();
 
 	if (CurrentWeaponIndex == INDEX_NONE)
 	{
-		EquipWeapon(Inventory.Weapons[0]);
+		EquipWeapon(Inventory.GetWeapon(0));
 	}
 	else
 	{
-		EquipWeapon(Inventory.Weapons[(CurrentWeaponIndex + 1) % Inventory.Weapons.Num()]);
+		EquipWeapon(Inventory.GetWeapon((CurrentWeaponIndex + 1) % Inventory.Num()));
 	}
 }
 
 void AGSHeroCharacter::PreviousWeapon()
 {
-	if (Inventory.Weapons.Num() < 2)
+	if (Inventory.Num() < 2)
 	{
 		return;
 	}
 
-	int32 CurrentWeaponIndex = Inventory.Weapons.Find(CurrentWeapon);
+	int32 CurrentWeaponIndex = Inventory.IndexOfWeapon(CurrentWeapon);
 
 	UnEquipCurrentWeapon();
 
 	if (CurrentWeaponIndex == INDEX_NONE)
 	{
-		EquipWeapon(Inventory.Weapons[0]);
+		EquipWeapon(Inventory.GetWeapon(0));
 	}
 	else
 	{
-		int32 IndexOfPrevWeapon = FMath::Abs(CurrentWeaponIndex - 1 + Inventory.Weapons.Num()) % Inventory.Weapons.Num();
-		EquipWeapon(Inventory.Weapons[IndexOfPrevWeapon]);
+		int32 IndexOfPrevWeapon = FMath::Abs(CurrentWeaponIndex - 1 + Inventory.Num()) % Inventory.Num();
+		EquipWeapon(Inventory.GetWeapon(IndexOfPrevWeapon));
 	}
 }
 
@@ -559,7 +684,7 @@ int32 AGSHeroCharacter::GetSecondaryReserveAmmo() const
 
 int32 AGSHeroCharacter::GetNumWeapons() const
 {
-	return Inventory.Weapons.Num();
+	return Inventory.Num();
 }
 
 bool AGSHeroCharacter::IsAvailableForInteraction_Implementation(UPrimitiveComponent* InteractionComponent) const
@@ -668,6 +793,11 @@ void AGSHeroCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
 		AbilitySystemComponent->AddLooseGameplayTag(CurrentWeaponTag);
 	}
 
+	if (UGSFloatingStatusBarSubsystem* StatusBars = GetWorld()->GetSubsystem<UGSFloatingStatusBarSubsystem>())
+	{
+		StatusBars->UnregisterStatusBar(this);
+	}
+
 	Super::EndPlay(EndPlayReason);
 }
 
@@ -784,8 +914,10 @@ void AGSHeroCharacter::SetPerspective(bool InIsFirstPersonPerspective)
 
 void AGSHeroCharacter::InitializeFloatingStatusBar()
 {
+	UGSFloatingStatusBarSubsystem* StatusBars = GetWorld()->GetSubsystem<UGSFloatingStatusBarSubsystem>();
+
 	// Only create once
-	if (UIFloatingStatusBar || !IsValid(AbilitySystemComponent))
+	if (!StatusBars || StatusBars->IsStatusBarRegistered(this) || !IsValid(AbilitySystemComponent))
 	{
 		return;
 	}
@@ -806,21 +938,8 @@ void AGSHeroCharacter::InitializeFloatingStatusBar()
 	AGSPlayerController* PC = Cast<AGSPlayerController>(UGameplayStatics::GetPlayerController(GetWorld(), 0));
 	if (PC && PC->IsLocalPlayerController())
 	{
-		if (UIFloatingStatusBarClass)
-		{
-			UIFloatingStatusBar = CreateWidget<UGSFloatingStatusBarWidget>(PC, UIFloatingStatusBarClass);
-			if (UIFloatingStatusBar && UIFloatingStatusBarComponent)
-			{
-				UIFloatingStatusBarComponent->SetWidget(UIFloatingStatusBar);
-
-				// Setup the floating status bar
-				UIFloatingStatusBar->SetHealthPercentage(GetHealth() / GetMaxHealth());
-				UIFloatingStatusBar->SetManaPercentage(GetMana() / GetMaxMana());
-				UIFloatingStatusBar->SetShieldPercentage(GetShield() / GetMaxShield());
-				UIFloatingStatusBar->OwningCharacter = this;
-				UIFloatingStatusBar->SetCharacterName(CharacterName);
-			}
-		}
+		// The subsystem lends us a pooled widget while we're on screen and keeps it up to date
+		StatusBars->RegisterStatusBar(this, UIFloatingStatusBarComponent, UIFloatingStatusBarClass, CharacterName);
 	}
 }
 
@@ -843,6 +962,8 @@ void AGSHeroCharacter::OnRep_PlayerState()
 
 		AbilitySystemComponent->AbilityFailedCallbacks.AddUObject(this, &AGSHeroCharacter::OnAbilityActivationFailed);
 
+		BindInteractionAvailabilityTags();
+
 		// Set the AttributeSetBase for convenience attribute functions
 		AttributeSetBase = PS->GetAttributeSetBase();
 		
@@ -915,6 +1036,8 @@ void AGSHeroCharacter::SpawnDefaultInventory()
 		return;
 	}
 
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSInventorySpawnDefault);
+
 	int32 NumWeaponClasses = DefaultInventoryWeaponClasses.Num();
 	for (int32 i = 0; i < NumWeaponClasses; i++)
 	{
@@ -928,6 +1051,7 @@ void AGSHeroCharacter::SpawnDefaultInventory()
 			FTransform::Identity, this, this, ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
 		NewWeapon->bSpawnWithCollision = false;
 		NewWeapon->FinishSpawning(FTransform::Identity);
+		GS_COUNT_ALLOCATIONS(STAT_GSInventoryWeaponsSpawned, 1);
 
 		bool bEquipFirstWeapon = i == 0;
 		AddWeaponToInventory(NewWeapon, bEquipFirstWeapon);
@@ -949,15 +1073,7 @@ bool AGSHeroCharacter::DoesWeaponExistInInventory(AGSWeapon* InWeapon)
 {
 	//UE_LOG(LogTemp, Log, TEXT("%s InWeapon class %s"), *FString(__FUNCTION__), *InWeapon->GetClass()->GetName());
 
-	for (AGSWeapon* Weapon : Inventory.Weapons)
-	{
-		if (Weapon && InWeapon && Weapon->GetClass() == InWeapon->GetClass())
-		{
-			return true;
-		}
-	}
-
-	return false;
+	return InWeapon && Inventory.ContainsWeaponClass(InWeapon->GetClass());
 }
 
 void AGSHeroCharacter::SetCurrentWeapon(AGSWeapon* NewWeapon, AGSWeapon* LastWeapon)
@@ -1111,6 +1227,26 @@ void AGSHeroCharacter::CurrentWeaponSecondaryReserveAmmoChanged(const FOnAttribu
 	}
 }
 
+void AGSHeroCharacter::BindInteractionAvailabilityTags()
+{
+	// The ASC lives on the PlayerState and outlives us, so don't stack bindings when this is called again
+	AbilitySystemComponent->RegisterGameplayTagEvent(KnockedDownTag).Remove(KnockedDownTagChangedDelegateHandle);
+	AbilitySystemComponent->RegisterGameplayTagEvent(InteractingTag).Remove(InteractingTagChangedDelegateHandle);
+
+	KnockedDownTagChangedDelegateHandle = AbilitySystemComponent->RegisterGameplayTagEvent(KnockedDownTag)
+		.AddUObject(this, &AGSHeroCharacter::InteractionAvailabilityTagChanged);
+	InteractingTagChangedDelegateHandle = AbilitySystemComponent->RegisterGameplayTagEvent(InteractingTag)
+		.AddUObject(this, &AGSHeroCharacter::InteractionAvailabilityTagChanged);
+}
+
+void AGSHeroCharacter::InteractionAvailabilityTagChanged(const FGameplayTag CallbackTag, int32 NewCount)
+{
+	if (UGSInteractableSubsystem* InteractableSubsystem = GetWorld()->GetSubsystem<UGSInteractableSubsystem>())
+	{
+		InteractableSubsystem->NotifyAvailabilityChanged(this);
+	}
+}
+
 void AGSHeroCharacter::WeaponChangingDelayReplicationTagChanged(const FGameplayTag CallbackTag, int32 NewCount)
 {
 	if (CallbackTag == WeaponChangingDelayReplicationTag)
@@ -1133,7 +1269,7 @@ void AGSHeroCharacter::OnRep_CurrentWeapon(AGSWeapon* LastWeapon)
 
 void AGSHeroCharacter::OnRep_Inventory()
 {
-	if (GetLocalRole() == ROLE_AutonomousProxy && Inventory.Weapons.Num() > 0 && !CurrentWeapon)
+	if (GetLocalRole() == ROLE_AutonomousProxy && Inventory.Num() > 0 && !CurrentWeapon)
 	{
 		// Since we don't replicate the CurrentWeapon to the owning client, this is a way to ask the Server to sync
 		// the CurrentWeapon after it's been spawned via replication from the Server.
@@ -0,0 +1,633 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "CoreMinimal.h"
+
+#if !UE_BUILD_SHIPPING
+
+#include "AbilitySystemComponent.h"
+#include "Characters/Abilities/AttributeSets/GSAttributeSetBase.h"
+#include "Characters/Abilities/GSDamageExecutionCalc.h"
+#include "Characters/Abilities/GSGATA_LineTrace.h"
+#include "Characters/Abilities/GSInteractableSubsystem.h"
+#include "Characters/Heroes/GSHeroCharacter.h"
+#include "Containers/Ticker.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameplayEffect.h"
+#include "GASShooter/GASShooter.h"
+#include "GSStats.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Tickable.h"
+#include "UObject/GCObject.h"
+#include "Weapons/GSWeapon.h"
+
+/**
+* Headless benchmark for the gameplay hot paths. Spawns heroes in the current world on the Server, waits for them to get
+* their default inventory and then times every scripted operation individually for a fixed seed. Results are written as
+* CSV to Saved/Profiling/Benchmarks.
+*
+* Trace confirms a configured line trace TargetActor through the current weapon's ability like firing does, alternating
+* rifle and batched shotgun settings. It spawns its own TargetActor per hero so that the pooled ones keep their settings.
+* Fire presses and releases primary fire through the ASC once per hero per frame so that fire rates and cooldowns behave
+* like they do in a match.
+*
+* Usage: GS.Benchmark.Run [Scenarios=All|Trace+Fire+Damage+WeaponSwap+Pickup+Interaction] [Heroes=16] [Iterations=50] [Seed=1337] [Quit=0]
+* Headless: UE4Editor-Cmd GASShooter <Map> -server -nullrhi -unattended -ExecCmds="GS.Benchmark.Run Quit=1"
+*
+* Allocations are the GS_COUNT_ALLOCATIONS counters (FGSAllocationCounter) that changed during a scenario. Replicated
+* bytes are the NetDriver's outgoing bytes while a scenario settles, so they are only non-zero with clients connected.
+*/
+namespace GSBenchmark
+{
+	static const TCHAR* ScenarioNames[] = { TEXT("Trace"), TEXT("Fire"), TEXT("Damage"), TEXT("WeaponSwap"), TEXT("Pickup"), TEXT("Interaction") };
+
+	enum class EScenario : uint8
+	{
+		Trace,
+		Fire,
+		Damage,
+		WeaponSwap,
+		Pickup,
+		Interaction,
+		Num
+	};
+
+	enum class EState : uint8
+	{
+		WaitingForInventory,
+		Firing,
+		Settling,
+		Finished
+	};
+
+	struct FScenarioResult
+	{
+		EScenario Scenario;
+		TArray<double> OpMicroseconds;
+		double TotalMilliseconds = 0.0;
+		// GS_COUNT_ALLOCATIONS totals that changed while the scenario ran
+		TMap<FName, int64> AllocationDeltas;
+		uint32 ReplicatedBytes = 0;
+		int32 NumClients = 0;
+	};
+
+	// Destroys the finished runner from the core ticker, it can't destroy itself while it's ticking
+	static bool ReleaseActiveRunner(float DeltaTime);
+
+	class FRunner : public FTickableGameObject, public FGCObject
+	{
+	public:
+		FRunner(UWorld* InWorld, const TArray<EScenario>& InScenarios, int32 InNumHeroes, int32 InIterations, int32 InSeed, bool bInQuitWhenDone)
+			: World(InWorld), Scenarios(InScenarios), NumHeroes(InNumHeroes), Iterations(InIterations), Seed(InSeed), bQuitWhenDone(bInQuitWhenDone),
+			RandomStream(InSeed), State(EState::WaitingForInventory), StateTime(0.0f), NextScenario(0), NextIteration(0), SettleFrames(0), OutBytesBeforeSettle(0),
+			DamageEffect(nullptr)
+		{
+			DamageTag = FGameplayTag::RequestGameplayTag("Data.Damage");
+			SpawnHeroes();
+			CreateDamageEffect();
+		}
+
+		virtual ~FRunner()
+		{
+			Cleanup();
+		}
+
+		bool IsFinished() const
+		{
+			return State == EState::Finished;
+		}
+
+		// FTickableGameObject
+		virtual void Tick(float DeltaTime) override
+		{
+			StateTime += DeltaTime;
+
+			switch (State)
+			{
+			case EState::WaitingForInventory:
+				// Default inventories are given the tick after possession
+				if (AreHeroesReady() || StateTime > 5.0f)
+				{
+					RunNextScenario();
+				}
+				break;
+			case EState::Firing:
+				RunIterations(Results.Last(), 1);
+				if (++NextIteration >= Iterations)
+				{
+					EndScenario(Results.Last());
+				}
+				break;
+			case EState::Settling:
+				// Give replication a few net ticks to send what the scenario changed
+				if (--SettleFrames <= 0)
+				{
+					FScenarioResult& Result = Results.Last();
+					if (UNetDriver* NetDriver = World->GetNetDriver())
+					{
+						Result.ReplicatedBytes = NetDriver->OutTotalBytes - OutBytesBeforeSettle;
+						Result.NumClients = NetDriver->ClientConnections.Num();
+					}
+
+					RunNextScenario();
+				}
+				break;
+			default:
+				break;
+			}
+		}
+
+		virtual bool IsTickable() const override
+		{
+			return State != EState::Finished && World.IsValid();
+		}
+
+		virtual TStatId GetStatId() const override
+		{
+			RETURN_QUICK_DECLARE_CYCLE_STAT(GSBenchmarkRunner, STATGROUP_Tickables);
+		}
+
+		virtual UWorld* GetTickableGameObjectWorld() const override
+		{
+			return World.Get();
+		}
+
+		// FGCObject
+		virtual void AddReferencedObjects(FReferenceCollector& Collector) override
+		{
+			Collector.AddReferencedObject(DamageEffect);
+		}
+
+		virtual FString GetReferencerName() const override
+		{
+			return TEXT("GSBenchmark::FRunner");
+		}
+
+	protected:
+		TWeakObjectPtr<UWorld> World;
+		TArray<EScenario> Scenarios;
+		int32 NumHeroes;
+		int32 Iterations;
+		int32 Seed;
+		bool bQuitWhenDone;
+
+		FRandomStream RandomStream;
+		EState State;
+		float StateTime;
+		int32 NextScenario;
+		int32 NextIteration;
+		int32 SettleFrames;
+		TMap<FName, int64> AllocationTotalsBefore;
+		uint32 OutBytesBeforeSettle;
+
+		TArray<TWeakObjectPtr<AGSHeroCharacter>> Heroes;
+		TArray<FScenarioResult> Results;
+
+		// Private TargetActors for the Trace scenario by hero index
+		TArray<TWeakObjectPtr<AGSGATA_LineTrace>> TraceTargetActors;
+
+		// Instant damage effect that runs UGSDamageExecutionCalc with SetByCaller damage
+		UGameplayEffect* DamageEffect;
+		FGameplayTag DamageTag;
+
+		void SpawnHeroes()
+		{
+			UClass* HeroClass = StaticLoadClass(UObject::StaticClass(), nullptr, TEXT("/Game/GASShooter/Characters/Hero/BP_HeroCharacter.BP_HeroCharacter_C"));
+			if (!HeroClass)
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s Failed to find HeroClass. If it was moved, please update the reference location in C++."), *FString(__FUNCTION__));
+				return;
+			}
+
+			FActorSpawnParameters SpawnParameters;
+			SpawnParameters.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+			// Square grid 3m apart, facing +X so that traces have something to hit
+			const int32 RowSize = FMath::Max(FMath::CeilToInt(FMath::Sqrt(static_cast<float>(NumHeroes))), 1);
+			for (int32 i = 0; i < NumHeroes; i++)
+			{
+				const FVector Location(300.0f * (i / RowSize), 300.0f * (i % RowSize), 200.0f);
+				AGSHeroCharacter* Hero = World->SpawnActor<AGSHeroCharacter>(HeroClass, Location, FRotator::ZeroRotator, SpawnParameters);
+				if (Hero)
+				{
+					Hero->SpawnDefaultController();
+					Heroes.Add(Hero);
+				}
+			}
+		}
+
+		void CreateDamageEffect()
+		{
+			DamageEffect = NewObject<UGameplayEffect>(GetTransientPackage(), FName(TEXT("GE_GSBenchmarkDamage")));
+			DamageEffect->DurationPolicy = EGameplayEffectDurationType::Instant;
+
+			FGameplayEffectExecutionDefinition Execution;
+			Execution.CalculationClass = UGSDamageExecutionCalc::StaticClass();
+			DamageEffect->Executions.Add(Execution);
+		}
+
+		bool AreHeroesReady() const
+		{
+			for (const TWeakObjectPtr<AGSHeroCharacter>& Hero : Heroes)
+			{
+				if (!Hero.IsValid() || !Hero->GetAbilitySystemComponent() || Hero->GetNumWeapons() < 2)
+				{
+					return false;
+				}
+			}
+
+			return true;
+		}
+
+		void RunNextScenario()
+		{
+			if (!Scenarios.IsValidIndex(NextScenario))
+			{
+				Finish();
+				return;
+			}
+
+			FScenarioResult& Result = Results.AddDefaulted_GetRef();
+			Result.Scenario = Scenarios[NextScenario++];
+			Result.OpMicroseconds.Reserve(Iterations * Heroes.Num());
+
+			FGSAllocationCounter::GetTotals(AllocationTotalsBefore);
+
+			if (Result.Scenario == EScenario::Fire)
+			{
+				// Abilities have fire rates and cooldowns, so fire once per hero per frame
+				NextIteration = 0;
+				State = EState::Firing;
+				return;
+			}
+
+			RunIterations(Result, Iterations);
+			EndScenario(Result);
+		}
+
+		void RunIterations(FScenarioResult& Result, int32 NumIterations)
+		{
+			const double StartTime = FPlatformTime::Seconds();
+
+			for (int32 Iteration = 0; Iteration < NumIterations; Iteration++)
+			{
+				for (int32 i = 0; i < Heroes.Num(); i++)
+				{
+					RunOperation(Result, i);
+				}
+			}
+
+			Result.TotalMilliseconds += (FPlatformTime::Seconds() - StartTime) * 1000.0;
+		}
+
+		void EndScenario(FScenarioResult& Result)
+		{
+			TMap<FName, int64> AllocationTotalsAfter;
+			FGSAllocationCounter::GetTotals(AllocationTotalsAfter);
+
+			for (const TPair<FName, int64>& Total : AllocationTotalsAfter)
+			{
+				const int64 Delta = Total.Value - AllocationTotalsBefore.FindRef(Total.Key);
+				if (Delta != 0)
+				{
+					Result.AllocationDeltas.Add(Total.Key, Delta);
+				}
+			}
+
+			UNetDriver* NetDriver = World->GetNetDriver();
+			OutBytesBeforeSettle = NetDriver ? NetDriver->OutTotalBytes : 0;
+			SettleFrames = 30;
+			State = EState::Settling;
+		}
+
+		// The current weapon's instanced ability, to drive TargetActors like the weapon's abilities do
+		UGameplayAbility* FindWeaponAbility(AGSHeroCharacter* Hero) const
+		{
+			AGSWeapon* CurrentWeapon = Hero->GetCurrentWeapon();
+			UAbilitySystemComponent* ASC = Hero->GetAbilitySystemComponent();
+			if (!CurrentWeapon || !ASC)
+			{
+				return nullptr;
+			}
+
+			for (const FGameplayAbilitySpec& Spec : ASC->GetActivatableAbilities())
+			{
+				if (Spec.SourceObject == CurrentWeapon && Spec.GetPrimaryInstance())
+				{
+					return Spec.GetPrimaryInstance();
+				}
+			}
+
+			return nullptr;
+		}
+
+		void RunOperation(FScenarioResult& Result, int32 HeroIndex)
+		{
+			AGSHeroCharacter* Hero = Heroes[HeroIndex].Get();
+			if (!Hero)
+			{
+				return;
+			}
+
+			switch (Result.Scenario)
+			{
+			case EScenario::Trace:
+			{
+				UGameplayAbility* WeaponAbility = FindWeaponAbility(Hero);
+				AGSGATA_LineTrace* TargetActor = WeaponAbility ? GetTraceTargetActor(HeroIndex) : nullptr;
+				if (!TargetActor)
+				{
+					return;
+				}
+
+				// Every other hero traces like a shotgun so that the batched pellet path is covered too
+				const bool bPellets = HeroIndex % 2 == 1;
+
+				FGameplayAbilityTargetingLocationInfo StartLocation;
+				StartLocation.LocationType = EGameplayAbilityTargetingLocationType::LiteralTransform;
+				StartLocation.LiteralTransform = FTransform(Hero->GetPawnViewLocation());
+
+				TargetActor->Configure(StartLocation, FGameplayTag(), FGameplayTag(), TargetActor->TraceProfile, FGameplayTargetDataFilterHandle(), nullptr,
+					FWorldReticleParameters(), false, true, false, false, true, true, false, 10000.0f, bPellets ? 5.0f : RandomStream.FRandRange(0.0f, 2.0f),
+					0.0f, 0.0f, 0.0f, 1, bPellets ? 8 : 1);
+				TargetActor->bBatchPelletTraces = bPellets;
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				TargetActor->StartTargeting(WeaponAbility);
+				TargetActor->ConfirmTargetingAndContinue();
+				TargetActor->StopTargeting();
+				RecordOperation(Result, StartCycles);
+				break;
+			}
+			case EScenario::Fire:
+			{
+				AGSWeapon* CurrentWeapon = Hero->GetCurrentWeapon();
+				UAbilitySystemComponent* ASC = Hero->GetAbilitySystemComponent();
+				if (!CurrentWeapon || !ASC)
+				{
+					return;
+				}
+
+				// Never run dry so that every shot runs the same code
+				CurrentWeapon->SetPrimaryClipAmmo(CurrentWeapon->GetMaxPrimaryClipAmmo());
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				ASC->AbilityLocalInputPressed(static_cast<int32>(EGSAbilityInputID::PrimaryFire));
+				ASC->AbilityLocalInputReleased(static_cast<int32>(EGSAbilityInputID::PrimaryFire));
+				RecordOperation(Result, StartCycles);
+				break;
+			}
+			case EScenario::Damage:
+			{
+				AGSHeroCharacter* Target = Heroes[(HeroIndex + 1) % Heroes.Num()].Get();
+				UAbilitySystemComponent* SourceASC = Hero->GetAbilitySystemComponent();
+				UAbilitySystemComponent* TargetASC = Target ? Target->GetAbilitySystemComponent() : nullptr;
+				if (!SourceASC || !TargetASC)
+				{
+					return;
+				}
+
+				FGameplayEffectSpec Spec(DamageEffect, SourceASC->MakeEffectContext(), 1.0f);
+				Spec.SetSetByCallerMagnitude(DamageTag, RandomStream.FRandRange(1.0f, 10.0f));
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				SourceASC->ApplyGameplayEffectSpecToTarget(Spec, TargetASC);
+				RecordOperation(Result, StartCycles);
+
+				// Keep everyone alive so that every iteration runs the same code
+				TargetASC->SetNumericAttributeBase(UGSAttributeSetBase::GetHealthAttribute(), Target->GetMaxHealth());
+				TargetASC->SetNumericAttributeBase(UGSAttributeSetBase::GetShieldAttribute(), Target->GetMaxShield());
+				break;
+			}
+			case EScenario::WeaponSwap:
+			{
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Hero->NextWeapon();
+				RecordOperation(Result, StartCycles);
+				break;
+			}
+			case EScenario::Pickup:
+			{
+				AGSWeapon* CurrentWeapon = Hero->GetCurrentWeapon();
+				if (!CurrentWeapon)
+				{
+					return;
+				}
+
+				// A duplicate of a weapon we already have gets turned into ammo
+				AGSWeapon* Pickup = World->SpawnActorDeferred<AGSWeapon>(CurrentWeapon->GetClass(), FTransform(Hero->GetActorLocation()), nullptr, nullptr,
+					ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+				if (!Pickup)
+				{
+					return;
+				}
+
+				Pickup->bSpawnWithCollision = false;
+				Pickup->FinishSpawning(FTransform(Hero->GetActorLocation()));
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Hero->AddWeaponToInventory(Pickup);
+				RecordOperation(Result, StartCycles);
+				break;
+			}
+			case EScenario::Interaction:
+			{
+				UGSInteractableSubsystem* Interactables = World->GetSubsystem<UGSInteractableSubsystem>();
+				if (!Interactables)
+				{
+					return;
+				}
+
+				const uint64 StartCycles = FPlatformTime::Cycles64();
+				Interactables->HasInteractableInRange(Hero->GetActorLocation() + RandomStream.VRand() * 100.0f, 300.0f, Hero);
+				RecordOperation(Result, StartCycles);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+
+		AGSGATA_LineTrace* GetTraceTargetActor(int32 HeroIndex)
+		{
+			if (TraceTargetActors.Num() <= HeroIndex)
+			{
+				TraceTargetActors.SetNum(HeroIndex + 1);
+			}
+
+			if (!TraceTargetActors[HeroIndex].IsValid())
+			{
+				AGSGATA_LineTrace* TargetActor = World->SpawnActor<AGSGATA_LineTrace>();
+				if (TargetActor)
+				{
+					TargetActor->SetOwner(Heroes[HeroIndex].Get());
+				}
+
+				TraceTargetActors[HeroIndex] = TargetActor;
+			}
+
+			return TraceTargetActors[HeroIndex].Get();
+		}
+
+		static void RecordOperation(FScenarioResult& Result, uint64 StartCycles)
+		{
+			Result.OpMicroseconds.Add(FPlatformTime::ToMilliseconds64(FPlatformTime::Cycles64() - StartCycles) * 1000.0);
+		}
+
+		void Finish()
+		{
+			State = EState::Finished;
+
+			FString Csv = TEXT("Scenario,Seed,Heroes,Iterations,Ops,TotalMs,MeanUs,MinUs,P50Us,P95Us,MaxUs,Allocations,ReplicatedBytes,Clients\n");
+
+			for (FScenarioResult& Result : Results)
+			{
+				TArray<double>& Ops = Result.OpMicroseconds;
+				Ops.Sort();
+
+				double Sum = 0.0;
+				for (double Op : Ops)
+				{
+					Sum += Op;
+				}
+
+				// Space separated Stat=Delta pairs so that the CSV keeps one column
+				FString Allocations;
+				for (const TPair<FName, int64>& AllocationDelta : Result.AllocationDeltas)
+				{
+					Allocations += FString::Printf(TEXT("%s%s=%lld"), Allocations.IsEmpty() ? TEXT("") : TEXT(" "), *AllocationDelta.Key.ToString(), AllocationDelta.Value);
+				}
+
+				const int32 NumOps = Ops.Num();
+				const FString Line = FString::Printf(TEXT("%s,%d,%d,%d,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%s,%u,%d"),
+					ScenarioNames[static_cast<int32>(Result.Scenario)], Seed, Heroes.Num(), Iterations, NumOps, Result.TotalMilliseconds,
+					NumOps > 0 ? Sum / NumOps : 0.0,
+					NumOps > 0 ? Ops[0] : 0.0,
+					NumOps > 0 ? Ops[NumOps / 2] : 0.0,
+					NumOps > 0 ? Ops[FMath::Min(FMath::FloorToInt(NumOps * 0.95f), NumOps - 1)] : 0.0,
+					NumOps > 0 ? Ops.Last() : 0.0,
+					*Allocations, Result.ReplicatedBytes, Result.NumClients);
+
+				UE_LOG(LogTemp, Log, TEXT("%s %s"), *FString(__FUNCTION__), *Line);
+				Csv += Line + TEXT("\n");
+			}
+
+			const FString CsvPath = FPaths::Combine(FPaths::ProfilingDir(), TEXT("Benchmarks"),
+				FString::Printf(TEXT("GSBenchmark-%d-%s.csv"), Seed, *FDateTime::Now().ToString()));
+
+			if (FFileHelper::SaveStringToFile(Csv, *CsvPath))
+			{
+				UE_LOG(LogTemp, Log, TEXT("%s Wrote %s"), *FString(__FUNCTION__), *CsvPath);
+			}
+			else
+			{
+				UE_LOG(LogTemp, Error, TEXT("%s Failed to write %s"), *FString(__FUNCTION__), *CsvPath);
+			}
+
+			Cleanup();
+
+			FTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateStatic(&ReleaseActiveRunner));
+
+			if (bQuitWhenDone)
+			{
+				FPlatformMisc::RequestExit(false);
+			}
+		}
+
+		void Cleanup()
+		{
+			for (const TWeakObjectPtr<AGSHeroCharacter>& Hero : Heroes)
+			{
+				if (Hero.IsValid())
+				{
+					AController* Controller = Hero->GetController();
+					Hero->RemoveAllWeaponsFromInventory();
+					Hero->Destroy();
+
+					if (Controller)
+					{
+						Controller->Destroy();
+					}
+				}
+			}
+
+			Heroes.Empty();
+
+			for (const TWeakObjectPtr<AGSGATA_LineTrace>& TargetActor : TraceTargetActors)
+			{
+				if (TargetActor.IsValid())
+				{
+					TargetActor->Destroy();
+				}
+			}
+
+			TraceTargetActors.Empty();
+		}
+	};
+
+	static TUniquePtr<FRunner> ActiveRunner;
+
+	static bool ReleaseActiveRunner(float DeltaTime)
+	{
+		// A new run may already have replaced it
+		if (ActiveRunner.IsValid() && ActiveRunner->IsFinished())
+		{
+			ActiveRunner.Reset();
+		}
+
+		// Don't tick again
+		return false;
+	}
+
+	static void Run(const TArray<FString>& Args, UWorld* World)
+	{
+		if (!World || World->GetNetMode() == NM_Client)
+		{
+			UE_LOG(LogTemp, Error, TEXT("%s Benchmarks have to run on the Server"), *FString(__FUNCTION__));
+			return;
+		}
+
+		if (ActiveRunner.IsValid() && !ActiveRunner->IsFinished())
+		{
+			UE_LOG(LogTemp, Warning, TEXT("%s A benchmark is already running"), *FString(__FUNCTION__));
+			return;
+		}
+
+		const FString Params = FString::Join(Args, TEXT(" "));
+
+		int32 NumHeroes = 16;
+		int32 Iterations = 50;
+		int32 Seed = 1337;
+		bool bQuit = false;
+		FString ScenarioList = TEXT("All");
+
+		FParse::Value(*Params, TEXT("Heroes="), NumHeroes);
+		FParse::Value(*Params, TEXT("Iterations="), Iterations);
+		FParse::Value(*Params, TEXT("Seed="), Seed);
+		FParse::Bool(*Params, TEXT("Quit="), bQuit);
+		FParse::Value(*Params, TEXT("Scenarios="), ScenarioList);
+
+		TArray<EScenario> Scenarios;
+		for (int32 i = 0; i < static_cast<int32>(EScenario::Num); i++)
+		{
+			if (ScenarioList == TEXT("All") || ScenarioList.Contains(ScenarioNames[i]))
+			{
+				Scenarios.Add(static_cast<EScenario>(i));
+			}
+		}
+
+		UE_LOG(LogTemp, Log, TEXT("%s Heroes: %d Iterations: %d Seed: %d Scenarios: %s"), *FString(__FUNCTION__), NumHeroes, Iterations, Seed, *ScenarioList);
+
+		ActiveRunner = MakeUnique<FRunner>(World, Scenarios, FMath::Max(NumHeroes, 2), FMath::Max(Iterations, 1), Seed, bQuit);
+	}
+}
+
+static FAutoConsoleCommandWithWorldAndArgs RunBenchmarkCommand(
+	TEXT("GS.Benchmark.Run"),
+	TEXT("Times scripted trace, fire, damage, weapon swap, pickup and interaction operations on spawned heroes and writes a CSV to Saved/Profiling/Benchmarks. Args: Scenarios=All Heroes=16 Iterations=50 Seed=1337 Quit=0"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&GSBenchmark::Run)
+);
+
+#endif
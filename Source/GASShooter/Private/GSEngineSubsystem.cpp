@@ -3,10 +3,42 @@
 
 #include "GSEngineSubsystem.h"
 #include "AbilitySystemGlobals.h"
+#include "Characters/Abilities/AttributeSets/GSAmmoAttributeSet.h"
+#include "Characters/Abilities/GSAbilitySystemGlobals.h"
+#include "Characters/Abilities/GSGE_AmmoGrant.h"
 
 void UGSEngineSubsystem::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
 
 	UAbilitySystemGlobals::Get().InitGlobalData();
+
+	RebuildAmmoTypes();
+	PreWorldInitializationDelegateHandle = FWorldDelegates::OnPreWorldInitialization.AddUObject(this, &UGSEngineSubsystem::OnPreWorldInitialization);
+}
+
+void UGSEngineSubsystem::Deinitialize()
+{
+	FWorldDelegates::OnPreWorldInitialization.Remove(PreWorldInitializationDelegateHandle);
+
+	Super::Deinitialize();
+}
+
+void UGSEngineSubsystem::RebuildAmmoTypes()
+{
+	UGSAmmoAttributeSet::RebuildAmmoTypes();
+
+	GetMutableDefault<UGSGE_AmmoGrant>()->RefreshAmmoModifiers();
+
+	const TSubclassOf<UGSGE_AmmoGrant> AmmoGrantEffect = UGSAbilitySystemGlobals::GSGet().AmmoGrantEffect;
+	if (AmmoGrantEffect && AmmoGrantEffect != UGSGE_AmmoGrant::StaticClass())
+	{
+		AmmoGrantEffect->GetDefaultObject<UGSGE_AmmoGrant>()->RefreshAmmoModifiers();
+	}
+}
+
+void UGSEngineSubsystem::OnPreWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS)
+{
+	// Picks up config and hot reload changes for every PIE session and map
+	RebuildAmmoTypes();
 }
@@ -0,0 +1,65 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "GSStats.h"
+
+CSV_DEFINE_CATEGORY_MODULE(GASSHOOTER_API, GASShooter, true);
+
+DEFINE_STAT(STAT_GSTracePerformTrace);
+DEFINE_STAT(STAT_GSTraceConfirmTargeting);
+DEFINE_STAT(STAT_GSTraceTick);
+DEFINE_STAT(STAT_GSTraceScratchBytesAllocated);
+DEFINE_STAT(STAT_GSTraceTargetActorsSpawned);
+
+DEFINE_STAT(STAT_GSAbilityLocalInputPressed);
+DEFINE_STAT(STAT_GSBatchRPCTryActivateAbility);
+
+DEFINE_STAT(STAT_GSDamageExecution);
+DEFINE_STAT(STAT_GSAttributePostExecute);
+
+DEFINE_STAT(STAT_GSInventoryAddWeapon);
+DEFINE_STAT(STAT_GSInventoryRemoveWeapon);
+DEFINE_STAT(STAT_GSInventoryEquipWeapon);
+DEFINE_STAT(STAT_GSInventorySpawnDefault);
+DEFINE_STAT(STAT_GSInventoryWeaponsSpawned);
+
+DEFINE_STAT(STAT_GSMontagePlayForMesh);
+DEFINE_STAT(STAT_GSMontageUpdateReplicatedData);
+DEFINE_STAT(STAT_GSMontageOnRep);
+
+DEFINE_STAT(STAT_GSProjectileIntegrate);
+DEFINE_STAT(STAT_GSProjectileSweep);
+DEFINE_STAT(STAT_GSProjectileVisualsSpawned);
+
+DEFINE_STAT(STAT_GSPickupRespawnBatch);
+
+DEFINE_STAT(STAT_GSSpawnScoring);
+
+DEFINE_STAT(STAT_GSHUDUpdateStatusBars);
+DEFINE_STAT(STAT_GSHUDFlushDamageNumbers);
+DEFINE_STAT(STAT_GSHUDShowDamageNumbers);
+DEFINE_STAT(STAT_GSHUDStatusBarWidgetsCreated);
+DEFINE_STAT(STAT_GSHUDDamageNumberWidgetsCreated);
+
+#if !UE_BUILD_SHIPPING
+
+// Every call site's counter, linked as they are first hit
+static FGSAllocationCounter* FirstAllocationCounter = nullptr;
+
+FGSAllocationCounter::FGSAllocationCounter(const TCHAR* InStatName)
+	: StatName(InStatName), Total(0), Next(FirstAllocationCounter)
+{
+	FirstAllocationCounter = this;
+}
+
+void FGSAllocationCounter::GetTotals(TMap<FName, int64>& OutTotals)
+{
+	OutTotals.Reset();
+
+	for (const FGSAllocationCounter* Counter = FirstAllocationCounter; Counter; Counter = Counter->Next)
+	{
+		OutTotals.FindOrAdd(Counter->StatName) += Counter->Total;
+	}
+}
+
+#endif
@@ -8,10 +8,12 @@
 #include "Characters/GSCharacterBase.h"
 #include "Components/CapsuleComponent.h"
 #include "GASShooter/GASShooter.h"
+#include "GASShooter/GASShooterGameStateBase.h"
+#include "Items/Pickups/GSPickupStateComponent.h"
+#include "Items/Pickups/GSPickupSubsystem.h"
 #include "Kismet/GameplayStatics.h"
 #include "Net/UnrealNetwork.h"
 #include "Sound/SoundCue.h"
-#include "TimerManager.h"
 
 // Sets default values
 AGSPickup::AGSPickup()
@@ -21,6 +23,7 @@ AGSPickup::AGSPickup()
 	bIsActive = true;
 	bCanRespawn = true;
 	RespawnTime = 5.0f;
+	PickupStateIndex = INDEX_NONE;
 
 	CollisionComp = CreateDefaultSubobject<UCapsuleComponent>(FName("CollisionComp"));
 	CollisionComp->InitCapsuleSize(40.0f, 50.0f);
@@ -60,18 +63,24 @@ bool AGSPickup::K2_CanBePickedUp_Implementation(AGSCharacterBase* TestCharacter)
 	return true;
 }
 
+bool AGSPickup::UsesSharedPickupState() const
+{
+	// Pickups that destroy themselves have to replicate that
+	return IsNetStartupActor() && bCanRespawn && RespawnTime > 0.0f;
+}
+
 void AGSPickup::PickupOnTouch(AGSCharacterBase* Pawn)
 {
 	if (CanBePickedUp(Pawn))
 	{
 		GivePickupTo(Pawn);
 		PickedUpBy = Pawn;
-		bIsActive = false;
+		SetIsActive(false);
 		OnPickedUp();
 
 		if (bCanRespawn && RespawnTime > 0.0f)
 		{
-			GetWorldTimerManager().SetTimer(TimerHandle_RespawnPickup, this, &AGSPickup::RespawnPickup, RespawnTime, false);
+			GetWorld()->GetSubsystem<UGSPickupSubsystem>()->ScheduleRespawn(this, RespawnTime);
 		}
 		else
 		{
@@ -128,20 +137,31 @@ void AGSPickup::OnPickedUp()
 	{
 		UGameplayStatics::SpawnSoundAttached(PickupSound, PickedUpBy->GetRootComponent());
 	}
+	else if (PickupSound && PickupStateIndex != INDEX_NONE)
+	{
+		// Clients don't know who picked up a pickup using the shared state
+		UGameplayStatics::SpawnSoundAtLocation(this, PickupSound, GetActorLocation());
+	}
 }
 
 void AGSPickup::RespawnPickup()
 {
-	bIsActive = true;
+	SetIsActive(true);
 	PickedUpBy = NULL;
 	OnRespawned();
+}
 
-	TSet<AActor*> OverlappingPawns;
-	GetOverlappingActors(OverlappingPawns, AGSCharacterBase::StaticClass());
+void AGSPickup::SetIsActive(bool bNewIsActive)
+{
+	bIsActive = bNewIsActive;
 
-	for (AActor* OverlappingPawn : OverlappingPawns)
+	if (PickupStateIndex != INDEX_NONE)
 	{
-		PickupOnTouch(CastChecked<AGSCharacterBase>(OverlappingPawn));
+		AGASShooterGameStateBase* GameState = GetWorld()->GetGameState<AGASShooterGameStateBase>();
+		if (GameState && GameState->GetPickupState())
+		{
+			GameState->GetPickupState()->SetPickupActive(PickupStateIndex, bIsActive);
+		}
 	}
 }
 
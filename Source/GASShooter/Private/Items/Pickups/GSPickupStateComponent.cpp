@@ -0,0 +1,139 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Items/Pickups/GSPickupStateComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "Items/Pickups/GSPickup.h"
+#include "Net/UnrealNetwork.h"
+
+void FGSPickupStateWord::PostReplicatedAdd(const FGSPickupStateBits& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnWordReplicated(*this);
+	}
+}
+
+void FGSPickupStateWord::PostReplicatedChange(const FGSPickupStateBits& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnWordReplicated(*this);
+	}
+}
+
+UGSPickupStateComponent::UGSPickupStateComponent()
+{
+	PrimaryComponentTick.bCanEverTick = false;
+	SetIsReplicatedByDefault(true);
+
+	PickupBits.Owner = this;
+	bIndexBuilt = false;
+}
+
+void UGSPickupStateComponent::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(UGSPickupStateComponent, PickupBits);
+}
+
+void UGSPickupStateComponent::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (GetOwnerRole() != ROLE_Authority)
+	{
+		return;
+	}
+
+	BuildIndex();
+
+	PickupBits.Words.SetNum(FMath::DivideAndRoundUp(Pickups.Num(), 32));
+	for (int32 i = 0; i < PickupBits.Words.Num(); i++)
+	{
+		FGSPickupStateWord& Word = PickupBits.Words[i];
+		Word.WordIndex = static_cast<uint16>(i);
+
+		for (int32 Bit = 0; Bit < 32 && i * 32 + Bit < Pickups.Num(); Bit++)
+		{
+			if (Pickups[i * 32 + Bit]->bIsActive)
+			{
+				Word.Bits |= 1u << Bit;
+			}
+		}
+
+		PickupBits.MarkItemDirty(Word);
+	}
+}
+
+void UGSPickupStateComponent::SetPickupActive(int32 PickupIndex, bool bActive)
+{
+	const int32 WordIndex = PickupIndex / 32;
+	if (!PickupBits.Words.IsValidIndex(WordIndex))
+	{
+		return;
+	}
+
+	FGSPickupStateWord& Word = PickupBits.Words[WordIndex];
+	const uint32 NewBits = bActive ? Word.Bits | (1u << (PickupIndex % 32)) : Word.Bits & ~(1u << (PickupIndex % 32));
+	if (NewBits != Word.Bits)
+	{
+		Word.Bits = NewBits;
+		PickupBits.MarkItemDirty(Word);
+	}
+}
+
+void UGSPickupStateComponent::BuildIndex()
+{
+	bIndexBuilt = true;
+	Pickups.Reset();
+
+	UWorld* World = GetWorld();
+	for (TActorIterator<AGSPickup> It(World); It; ++It)
+	{
+		if (It->GetLevel() == World->PersistentLevel && It->UsesSharedPickupState())
+		{
+			Pickups.Add(*It);
+		}
+	}
+
+	// Names are the same everywhere, pointers and iteration order aren't
+	Pickups.Sort([](const AGSPickup& A, const AGSPickup& B)
+	{
+		return A.GetName() < B.GetName();
+	});
+
+	const bool bIsServer = GetOwnerRole() == ROLE_Authority;
+	for (int32 i = 0; i < Pickups.Num(); i++)
+	{
+		Pickups[i]->PickupStateIndex = i;
+
+		if (bIsServer)
+		{
+			Pickups[i]->SetReplicates(false);
+		}
+	}
+}
+
+void UGSPickupStateComponent::OnWordReplicated(const FGSPickupStateWord& Word)
+{
+	if (!bIndexBuilt)
+	{
+		BuildIndex();
+	}
+
+	const int32 FirstPickup = Word.WordIndex * 32;
+	for (int32 Bit = 0; Bit < 32 && FirstPickup + Bit < Pickups.Num(); Bit++)
+	{
+		AGSPickup* Pickup = Pickups[FirstPickup + Bit];
+		const bool bActive = (Word.Bits & (1u << Bit)) != 0;
+
+		if (IsValid(Pickup) && Pickup->bIsActive != bActive)
+		{
+			Pickup->bIsActive = bActive;
+			Pickup->OnRep_IsActive();
+		}
+	}
+}
@@ -0,0 +1,245 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Items/Pickups/GSPickupSubsystem.h"
+#include "Characters/GSCharacterBase.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "EngineUtils.h"
+#include "GSStats.h"
+#include "Items/Pickups/GSPickup.h"
+
+FGSPickupTimingWheel::FGSPickupTimingWheel()
+{
+	TickInterval = 0.1f;
+	CurrentTick = 0;
+	TimeSinceLastTick = 0.0f;
+	NumEntries = 0;
+}
+
+void FGSPickupTimingWheel::Schedule(AGSPickup* Pickup, float Delay)
+{
+	FEntry Entry;
+	Entry.Pickup = Pickup;
+	Entry.DueTick = CurrentTick + FMath::Max(FMath::CeilToInt(Delay / TickInterval), 1);
+
+	Insert(Entry);
+	NumEntries++;
+}
+
+void FGSPickupTimingWheel::Advance(float DeltaTime, TArray<TWeakObjectPtr<AGSPickup>>& OutDuePickups)
+{
+	TimeSinceLastTick += DeltaTime;
+
+	while (TimeSinceLastTick >= TickInterval && NumEntries > 0)
+	{
+		TimeSinceLastTick -= TickInterval;
+		CurrentTick++;
+
+		if (CurrentTick % NumSlots == 0)
+		{
+			const uint64 OuterTick = CurrentTick / NumSlots;
+			if (OuterTick % NumSlots == 0)
+			{
+				Reinsert(Overflow);
+			}
+
+			// Spread the next inner revolution's worth of entries over the inner wheel
+			Reinsert(OuterSlots[OuterTick % NumSlots]);
+		}
+
+		TArray<FEntry>& Slot = InnerSlots[CurrentTick % NumSlots];
+		for (const FEntry& Entry : Slot)
+		{
+			OutDuePickups.Add(Entry.Pickup);
+		}
+
+		NumEntries -= Slot.Num();
+		Slot.Reset();
+	}
+
+	// Nothing to wait for, don't build up time to catch up on later
+	if (NumEntries == 0)
+	{
+		TimeSinceLastTick = 0.0f;
+	}
+}
+
+void FGSPickupTimingWheel::Empty()
+{
+	for (int32 i = 0; i < NumSlots; i++)
+	{
+		InnerSlots[i].Empty();
+		OuterSlots[i].Empty();
+	}
+
+	Overflow.Empty();
+	NumEntries = 0;
+}
+
+void FGSPickupTimingWheel::Insert(const FEntry& Entry)
+{
+	const uint64 TicksLeft = Entry.DueTick > CurrentTick ? Entry.DueTick - CurrentTick : 0;
+
+	if (TicksLeft < NumSlots)
+	{
+		InnerSlots[Entry.DueTick % NumSlots].Add(Entry);
+	}
+	else if (TicksLeft < NumSlots * NumSlots)
+	{
+		OuterSlots[(Entry.DueTick / NumSlots) % NumSlots].Add(Entry);
+	}
+	else
+	{
+		Overflow.Add(Entry);
+	}
+}
+
+void FGSPickupTimingWheel::Reinsert(TArray<FEntry>& Entries)
+{
+	// Insert() can put entries back into the same list, so move them out first
+	TArray<FEntry> EntriesToInsert = MoveTemp(Entries);
+	Entries.Reset();
+
+	for (const FEntry& Entry : EntriesToInsert)
+	{
+		Insert(Entry);
+	}
+}
+
+UGSPickupSubsystem::UGSPickupSubsystem()
+{
+	PawnCellSize = 500.0f;
+}
+
+void UGSPickupSubsystem::Deinitialize()
+{
+	RespawnWheel.Empty();
+	DueRespawns.Empty();
+	PawnCells.Empty();
+
+	Super::Deinitialize();
+}
+
+void UGSPickupSubsystem::Tick(float DeltaTime)
+{
+	RespawnWheel.Advance(DeltaTime, DueRespawns);
+
+	if (DueRespawns.Num() > 0)
+	{
+		ProcessDueRespawns();
+	}
+}
+
+bool UGSPickupSubsystem::IsTickable() const
+{
+	// Only the Server respawns pickups
+	const UWorld* World = GetWorld();
+	return !HasAnyFlags(RF_ClassDefaultObject) && World && World->GetNetMode() != NM_Client && RespawnWheel.Num() > 0;
+}
+
+TStatId UGSPickupSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGSPickupSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UGSPickupSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UGSPickupSubsystem::ScheduleRespawn(AGSPickup* Pickup, float Delay)
+{
+	if (IsValid(Pickup))
+	{
+		RespawnWheel.Schedule(Pickup, Delay);
+	}
+}
+
+int32 UGSPickupSubsystem::GetNumScheduledRespawns() const
+{
+	return RespawnWheel.Num();
+}
+
+void UGSPickupSubsystem::ProcessDueRespawns()
+{
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSPickupRespawnBatch);
+
+	BuildPawnHash();
+
+	for (const TWeakObjectPtr<AGSPickup>& Pickup : DueRespawns)
+	{
+		// Destroyed while it was waiting
+		if (Pickup.IsValid())
+		{
+			Pickup->RespawnPickup();
+			GivePickupToOverlappingCharacter(Pickup.Get());
+		}
+	}
+
+	DueRespawns.Reset();
+	PawnCells.Reset();
+}
+
+void UGSPickupSubsystem::BuildPawnHash()
+{
+	PawnCells.Reset();
+
+	for (TActorIterator<AGSCharacterBase> It(GetWorld()); It; ++It)
+	{
+		AGSCharacterBase* Character = *It;
+		if (IsValid(Character) && Character->IsAlive())
+		{
+			PawnCells.FindOrAdd(GetPawnCell(Character->GetActorLocation())).Add(Character);
+		}
+	}
+}
+
+FIntPoint UGSPickupSubsystem::GetPawnCell(const FVector& Location) const
+{
+	return FIntPoint(FMath::FloorToInt(Location.X / PawnCellSize), FMath::FloorToInt(Location.Y / PawnCellSize));
+}
+
+void UGSPickupSubsystem::GivePickupToOverlappingCharacter(AGSPickup* Pickup)
+{
+	const UCapsuleComponent* PickupCapsule = Pickup->CollisionComp;
+	if (!PickupCapsule || PawnCells.Num() == 0)
+	{
+		return;
+	}
+
+	const FVector PickupLocation = PickupCapsule->GetComponentLocation();
+	const float PickupRadius = PickupCapsule->GetScaledCapsuleRadius();
+	const float PickupHalfHeight = PickupCapsule->GetScaledCapsuleHalfHeight();
+	const FIntPoint PickupCell = GetPawnCell(PickupLocation);
+
+	// Characters are never bigger than a cell, so only the neighbouring cells can overlap
+	for (int32 X = PickupCell.X - 1; X <= PickupCell.X + 1; X++)
+	{
+		for (int32 Y = PickupCell.Y - 1; Y <= PickupCell.Y + 1; Y++)
+		{
+			const TArray<AGSCharacterBase*>* Cell = PawnCells.Find(FIntPoint(X, Y));
+			if (!Cell)
+			{
+				continue;
+			}
+
+			for (AGSCharacterBase* Character : *Cell)
+			{
+				if (!IsValid(Character))
+				{
+					continue;
+				}
+
+				// Upright capsule vs upright capsule, treated as cylinders
+				const UCapsuleComponent* CharacterCapsule = Character->GetCapsuleComponent();
+				const FVector Delta = CharacterCapsule->GetComponentLocation() - PickupLocation;
+				if (Delta.Size2D() <= PickupRadius + CharacterCapsule->GetScaledCapsuleRadius()
+					&& FMath::Abs(Delta.Z) <= PickupHalfHeight + CharacterCapsule->GetScaledCapsuleHalfHeight())
+				{
+					Pickup->PickupOnTouch(Character);
+				}
+			}
+		}
+	}
+}
@@ -6,6 +6,7 @@
 #include "Characters/Abilities/AttributeSets/GSAttributeSetBase.h"
 #include "Characters/Abilities/GSAbilitySystemComponent.h"
 #include "Characters/Heroes/GSHeroCharacter.h"
+#include "GSStats.h"
 #include "Player/GSPlayerState.h"
 #include "UI/GSHUDWidget.h"
 #include "Weapons/GSWeapon.h"
@@ -147,15 +148,51 @@ void AGSPlayerController::SetHUDReticle(TSubclassOf<UGSHUDReticle> ReticleClass)
 	}
 }
 
-void AGSPlayerController::ShowDamageNumber_Implementation(float DamageAmount, AGSCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags)
+void AGSPlayerController::ShowDamageNumber(float DamageAmount, AGSCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags)
 {
+	if (!IsValid(TargetCharacter))
+	{
+		return;
+	}
+
+	if (PendingDamageNumbers.Num() == 0)
+	{
+		// Every pellet of a shotgun blast lands in the same frame
+		GetWorldTimerManager().SetTimerForNextTick(this, &AGSPlayerController::FlushDamageNumbers);
+	}
+
+	PendingDamageNumbers.FindOrAdd(TargetCharacter).Add(FGSDamageNumber(DamageAmount, DamageNumberTags));
+}
+
+void AGSPlayerController::FlushDamageNumbers()
+{
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSHUDFlushDamageNumbers);
+
+	for (const TPair<TWeakObjectPtr<AGSCharacterBase>, TArray<FGSDamageNumber>>& Pair : PendingDamageNumbers)
+	{
+		if (Pair.Key.IsValid())
+		{
+			ClientShowDamageNumbers(Pair.Key.Get(), Pair.Value);
+		}
+	}
+
+	PendingDamageNumbers.Reset();
+}
+
+void AGSPlayerController::ClientShowDamageNumbers_Implementation(AGSCharacterBase* TargetCharacter, const TArray<FGSDamageNumber>& DamageNumbers)
+{
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSHUDShowDamageNumbers);
+
 	if (IsValid(TargetCharacter))
 	{
-		TargetCharacter->AddDamageNumber(DamageAmount, DamageNumberTags);
+		for (const FGSDamageNumber& DamageNumber : DamageNumbers)
+		{
+			TargetCharacter->AddDamageNumber(DamageNumber.DamageAmount, DamageNumber.Tags);
+		}
 	}
 }
 
-bool AGSPlayerController::ShowDamageNumber_Validate(float DamageAmount, AGSCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags)
+bool AGSPlayerController::ClientShowDamageNumbers_Validate(AGSCharacterBase* TargetCharacter, const TArray<FGSDamageNumber>& DamageNumbers)
 {
 	return true;
 }
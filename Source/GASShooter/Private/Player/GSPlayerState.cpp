@@ -10,8 +10,14 @@
 #include "Player/GSPlayerController.h"
 #include "UI/GSFloatingStatusBarWidget.h"
 #include "UI/GSHUDWidget.h"
+#include "TimerManager.h"
 #include "Weapons/GSWeapon.h"
 
+static TAutoConsoleVariable<int32> CVarAdaptiveNetUpdateFrequency(
+	TEXT("GS.PlayerState.AdaptiveNetUpdateFrequency"),
+	1,
+	TEXT("Drop PlayerStates to their idle NetUpdateFrequency when nothing is happening on their ASC. 0: Always use the active rate, 1: Adaptive"));
+
 AGSPlayerState::AGSPlayerState()
 {
 	// Create ability system component, and set it to be explicitly replicated
@@ -29,10 +35,16 @@ AGSPlayerState::AGSPlayerState()
 
 	AmmoAttributeSet = CreateDefaultSubobject<UGSAmmoAttributeSet>(TEXT("AmmoAttributeSet"));
 
-	// Set PlayerState's NetUpdateFrequency to the same as the Character.
+	// Set PlayerState's NetUpdateFrequency to the same as the Character while the ability system is busy.
 	// Default is very low for PlayerStates and introduces perceived lag in the ability system.
-	// 100 is probably way too high for a shipping game, you can adjust to fit your needs.
-	NetUpdateFrequency = 100.0f;
+	// The Server drops to IdleNetUpdateFrequency when nothing on the ASC has changed for IdleDelay seconds.
+	ActiveNetUpdateFrequency = 100.0f;
+	IdleNetUpdateFrequency = 10.0f;
+	IdleDelay = 1.0f;
+	NetUpdateFrequencyEvaluationInterval = 0.25f;
+	NetUpdateFrequency = ActiveNetUpdateFrequency;
+	bNetUpdateFrequencyIdle = false;
+	LastReplicationActivityTime = 0.0f;
 
 	DeadTag = FGameplayTag::RequestGameplayTag("State.Dead");
 	KnockedDownTag = FGameplayTag::RequestGameplayTag("State.KnockedDown");
@@ -255,9 +267,127 @@ void AGSPlayerState::BeginPlay()
 
 		// Tag change callbacks
 		AbilitySystemComponent->RegisterGameplayTagEvent(KnockedDownTag, EGameplayTagEventType::NewOrRemoved).AddUObject(this, &AGSPlayerState::KnockDownTagChanged);
+
+		if (GetLocalRole() == ROLE_Authority)
+		{
+			BindReplicationActivityCallbacks();
+			LastReplicationActivityTime = GetWorld()->GetTimeSeconds();
+			GetWorldTimerManager().SetTimer(NetUpdateFrequencyEvaluationTimerHandle, this, &AGSPlayerState::EvaluateNetUpdateFrequency, NetUpdateFrequencyEvaluationInterval, true);
+		}
+	}
+}
+
+void AGSPlayerState::FlushReplication()
+{
+	if (GetLocalRole() != ROLE_Authority)
+	{
+		return;
+	}
+
+	NoteReplicationActivity();
+	ForceNetUpdate();
+}
+
+void AGSPlayerState::BindReplicationActivityCallbacks()
+{
+	TArray<FGameplayAttribute> Attributes;
+	for (const UAttributeSet* AttributeSet : AbilitySystemComponent->GetSpawnedAttributes())
+	{
+		if (AttributeSet)
+		{
+			UAttributeSet::GetAttributesFromSetClass(AttributeSet->GetClass(), Attributes);
+		}
+	}
+
+	for (const FGameplayAttribute& Attribute : Attributes)
+	{
+		AbilitySystemComponent->GetGameplayAttributeValueChangeDelegate(Attribute).AddWeakLambda(this, [this](const FOnAttributeChangeData& Data)
+		{
+			NoteReplicationActivity();
+		});
+	}
+
+	AbilitySystemComponent->RegisterGenericGameplayTagEvent().AddWeakLambda(this, [this](const FGameplayTag Tag, int32 NewCount)
+	{
+		NoteReplicationActivity();
+	});
+
+	AbilitySystemComponent->OnActiveGameplayEffectAddedDelegateToSelf.AddWeakLambda(this, [this](UAbilitySystemComponent* Target, const FGameplayEffectSpec& SpecApplied, FActiveGameplayEffectHandle ActiveHandle)
+	{
+		NoteReplicationActivity();
+	});
+
+	AbilitySystemComponent->OnAnyGameplayEffectRemovedDelegate().AddWeakLambda(this, [this](const FActiveGameplayEffect& RemovedEffect)
+	{
+		NoteReplicationActivity();
+	});
+
+	// Every predicted activation from the client ends up in one of these with a prediction key that it's waiting on us
+	// to acknowledge, so send it right away instead of waiting for the next idle net update.
+	AbilitySystemComponent->AbilityActivatedCallbacks.AddWeakLambda(this, [this](UGameplayAbility* Ability)
+	{
+		FlushReplication();
+	});
+
+	AbilitySystemComponent->AbilityFailedCallbacks.AddWeakLambda(this, [this](const UGameplayAbility* Ability, const FGameplayTagContainer& FailureReason)
+	{
+		FlushReplication();
+	});
+
+	AbilitySystemComponent->AbilityEndedCallbacks.AddWeakLambda(this, [this](UGameplayAbility* Ability)
+	{
+		NoteReplicationActivity();
+	});
+}
+
+void AGSPlayerState::NoteReplicationActivity()
+{
+	LastReplicationActivityTime = GetWorld()->GetTimeSeconds();
+
+	if (bNetUpdateFrequencyIdle)
+	{
+		bNetUpdateFrequencyIdle = false;
+		NetUpdateFrequency = ActiveNetUpdateFrequency;
+		ForceNetUpdate();
 	}
 }
 
+void AGSPlayerState::EvaluateNetUpdateFrequency()
+{
+	if (bNetUpdateFrequencyIdle)
+	{
+		if (CVarAdaptiveNetUpdateFrequency.GetValueOnGameThread() == 0)
+		{
+			NoteReplicationActivity();
+		}
+
+		return;
+	}
+
+	if (CVarAdaptiveNetUpdateFrequency.GetValueOnGameThread() == 0
+		|| GetWorld()->GetTimeSeconds() - LastReplicationActivityTime < IdleDelay
+		|| HasActiveAbilities())
+	{
+		return;
+	}
+
+	bNetUpdateFrequencyIdle = true;
+	NetUpdateFrequency = IdleNetUpdateFrequency;
+}
+
+bool AGSPlayerState::HasActiveAbilities() const
+{
+	for (const FGameplayAbilitySpec& Spec : AbilitySystemComponent->GetActivatableAbilities())
+	{
+		if (Spec.IsActive())
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 void AGSPlayerState::HealthChanged(const FOnAttributeChangeData& Data)
 {
 	// Check for and handle knockdown and death
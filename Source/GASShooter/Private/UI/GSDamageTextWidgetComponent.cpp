@@ -2,4 +2,43 @@
 
 
 #include "UI/GSDamageTextWidgetComponent.h"
+#include "Blueprint/UserWidget.h"
+#include "Characters/GSCharacterBase.h"
+#include "Engine/World.h"
 
+UGSDamageTextWidgetComponent::UGSDamageTextWidgetComponent()
+{
+	bReturnToPoolOnDestroy = false;
+}
+
+void UGSDamageTextWidgetComponent::DestroyComponent(bool bPromoteChildren)
+{
+	AGSCharacterBase* OwningCharacter = Cast<AGSCharacterBase>(GetOwner());
+
+	if (bReturnToPoolOnDestroy && IsValid(OwningCharacter) && !OwningCharacter->IsActorBeingDestroyed()
+		&& GetWorld() && !GetWorld()->bIsTearingDown)
+	{
+		OwningCharacter->ReleaseDamageNumber(this);
+		return;
+	}
+
+	Super::DestroyComponent(bPromoteChildren);
+}
+
+void UGSDamageTextWidgetComponent::ReleaseToPool()
+{
+	SetVisibility(false, true);
+	RemoveWidgetFromScreen();
+	SetComponentTickEnabled(false);
+}
+
+void UGSDamageTextWidgetComponent::ResetForReuse()
+{
+	const UGSDamageTextWidgetComponent* Defaults = GetClass()->GetDefaultObject<UGSDamageTextWidgetComponent>();
+	SetRelativeTransform(FTransform(Defaults->GetRelativeRotation(), Defaults->GetRelativeLocation(), Defaults->GetRelativeScale3D()));
+
+	if (UUserWidget* UserWidget = GetUserWidgetObject())
+	{
+		UserWidget->StopAllAnimations();
+	}
+}
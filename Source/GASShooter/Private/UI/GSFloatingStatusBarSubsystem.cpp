@@ -0,0 +1,272 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "UI/GSFloatingStatusBarSubsystem.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Characters/GSCharacterBase.h"
+#include "Components/WidgetComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GSStats.h"
+#include "UI/GSFloatingStatusBarWidget.h"
+
+static TAutoConsoleVariable<float> CVarStatusBarUpdateRate(
+	TEXT("GS.StatusBars.UpdateRate"),
+	10.0f,
+	TEXT("How many times per second floating status bars are culled and updated")
+);
+
+static TAutoConsoleVariable<float> CVarStatusBarMaxDistance(
+	TEXT("GS.StatusBars.MaxDistance"),
+	5000.0f,
+	TEXT("Floating status bars of Characters further than this from the camera are hidden and their widget is pooled")
+);
+
+static TAutoConsoleVariable<float> CVarStatusBarVisibleDelta(
+	TEXT("GS.StatusBars.VisibleDelta"),
+	0.005f,
+	TEXT("Smallest change in a bar's percentage (0-1) that is pushed to the widget")
+);
+
+UGSFloatingStatusBarSubsystem::UGSFloatingStatusBarSubsystem()
+{
+	TimeSinceLastUpdate = 0.0f;
+}
+
+void UGSFloatingStatusBarSubsystem::Deinitialize()
+{
+	Entries.Empty();
+	FreeWidgets.Empty();
+
+	Super::Deinitialize();
+}
+
+void UGSFloatingStatusBarSubsystem::Tick(float DeltaTime)
+{
+	TimeSinceLastUpdate += DeltaTime;
+
+	if (TimeSinceLastUpdate >= 1.0f / FMath::Max(CVarStatusBarUpdateRate.GetValueOnGameThread(), 1.0f))
+	{
+		TimeSinceLastUpdate = 0.0f;
+		UpdateStatusBars();
+	}
+}
+
+bool UGSFloatingStatusBarSubsystem::IsTickable() const
+{
+	// Only clients and listen servers draw status bars
+	const UWorld* World = GetWorld();
+	return !HasAnyFlags(RF_ClassDefaultObject) && World && World->GetNetMode() != NM_DedicatedServer && Entries.Num() > 0;
+}
+
+TStatId UGSFloatingStatusBarSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGSFloatingStatusBarSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UGSFloatingStatusBarSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+void UGSFloatingStatusBarSubsystem::RegisterStatusBar(AGSCharacterBase* Character, UWidgetComponent* WidgetComponent, TSubclassOf<UGSFloatingStatusBarWidget> WidgetClass, const FText& CharacterName)
+{
+	if (!IsValid(Character) || !WidgetComponent || !WidgetClass || IsStatusBarRegistered(Character))
+	{
+		return;
+	}
+
+	FGSFloatingStatusBarEntry& Entry = Entries.AddDefaulted_GetRef();
+	Entry.Character = Character;
+	Entry.WidgetComponent = WidgetComponent;
+	Entry.WidgetClass = WidgetClass;
+	Entry.CharacterName = CharacterName;
+
+	// Hidden until the next update decides that it's on screen
+	HideStatusBar(Entry);
+}
+
+void UGSFloatingStatusBarSubsystem::UnregisterStatusBar(AGSCharacterBase* Character)
+{
+	for (int32 i = 0; i < Entries.Num(); i++)
+	{
+		if (Entries[i].Character == Character)
+		{
+			HideStatusBar(Entries[i]);
+			Entries.RemoveAtSwap(i);
+			return;
+		}
+	}
+}
+
+bool UGSFloatingStatusBarSubsystem::IsStatusBarRegistered(const AGSCharacterBase* Character) const
+{
+	return Entries.ContainsByPredicate([Character](const FGSFloatingStatusBarEntry& Entry) { return Entry.Character == Character; });
+}
+
+UGSFloatingStatusBarWidget* UGSFloatingStatusBarSubsystem::GetStatusBarWidget(const AGSCharacterBase* Character) const
+{
+	const FGSFloatingStatusBarEntry* Entry = Entries.FindByPredicate([Character](const FGSFloatingStatusBarEntry& InEntry) { return InEntry.Character == Character; });
+	return Entry ? Entry->Widget : nullptr;
+}
+
+void UGSFloatingStatusBarSubsystem::UpdateStatusBars()
+{
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSHUDUpdateStatusBars);
+
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC || !PC->IsLocalController() || !PC->PlayerCameraManager)
+	{
+		return;
+	}
+
+	const FVector CameraLocation = PC->PlayerCameraManager->GetCameraLocation();
+	const FVector CameraDirection = PC->PlayerCameraManager->GetCameraRotation().Vector();
+
+	// Horizontal FOV is the widest, pad it a little so bars at the edge of the screen don't pop
+	const float MinViewDot = FMath::Cos(FMath::DegreesToRadians(FMath::Min(PC->PlayerCameraManager->GetFOVAngle() * 0.5f + 10.0f, 180.0f)));
+	const float MaxDistanceSquared = FMath::Square(CVarStatusBarMaxDistance.GetValueOnGameThread());
+
+	for (int32 i = Entries.Num() - 1; i >= 0; i--)
+	{
+		FGSFloatingStatusBarEntry& Entry = Entries[i];
+
+		const AGSCharacterBase* Character = Entry.Character.Get();
+		if (!Character || !Entry.WidgetComponent.IsValid())
+		{
+			HideStatusBar(Entry);
+			Entries.RemoveAtSwap(i);
+			continue;
+		}
+
+		const FVector ToCharacter = Entry.WidgetComponent->GetComponentLocation() - CameraLocation;
+		const bool bOnScreen = ToCharacter.SizeSquared() <= MaxDistanceSquared && FVector::DotProduct(ToCharacter.GetSafeNormal(), CameraDirection) >= MinViewDot;
+
+		if (!bOnScreen)
+		{
+			HideStatusBar(Entry);
+			continue;
+		}
+
+		if (!Entry.Widget)
+		{
+			ShowStatusBar(Entry);
+		}
+		else
+		{
+			UpdateStatusBarValues(Entry, false);
+		}
+	}
+}
+
+void UGSFloatingStatusBarSubsystem::UpdateStatusBarValues(FGSFloatingStatusBarEntry& Entry, bool bForce)
+{
+	const AGSCharacterBase* Character = Entry.Character.Get();
+	if (!Entry.Widget || !Character)
+	{
+		return;
+	}
+
+	const float VisibleDelta = CVarStatusBarVisibleDelta.GetValueOnGameThread();
+
+	const float MaxHealth = Character->GetMaxHealth();
+	const float HealthPercentage = MaxHealth > 0.0f ? Character->GetHealth() / MaxHealth : 0.0f;
+	if (bForce || FMath::Abs(HealthPercentage - Entry.HealthPercentage) >= VisibleDelta)
+	{
+		Entry.HealthPercentage = HealthPercentage;
+		Entry.Widget->SetHealthPercentage(HealthPercentage);
+	}
+
+	const float MaxMana = Character->GetMaxMana();
+	const float ManaPercentage = MaxMana > 0.0f ? Character->GetMana() / MaxMana : 0.0f;
+	if (bForce || FMath::Abs(ManaPercentage - Entry.ManaPercentage) >= VisibleDelta)
+	{
+		Entry.ManaPercentage = ManaPercentage;
+		Entry.Widget->SetManaPercentage(ManaPercentage);
+	}
+
+	const float MaxShield = Character->GetMaxShield();
+	const float ShieldPercentage = MaxShield > 0.0f ? Character->GetShield() / MaxShield : 0.0f;
+	if (bForce || FMath::Abs(ShieldPercentage - Entry.ShieldPercentage) >= VisibleDelta)
+	{
+		Entry.ShieldPercentage = ShieldPercentage;
+		Entry.Widget->SetShieldPercentage(ShieldPercentage);
+	}
+}
+
+UGSFloatingStatusBarWidget* UGSFloatingStatusBarSubsystem::AcquireWidget(TSubclassOf<UGSFloatingStatusBarWidget> WidgetClass)
+{
+	for (int32 i = FreeWidgets.Num() - 1; i >= 0; i--)
+	{
+		UGSFloatingStatusBarWidget* Widget = FreeWidgets[i];
+		if (!IsValid(Widget))
+		{
+			FreeWidgets.RemoveAtSwap(i);
+			continue;
+		}
+
+		if (Widget->GetClass() == WidgetClass)
+		{
+			FreeWidgets.RemoveAtSwap(i);
+			return Widget;
+		}
+	}
+
+	APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC || !PC->IsLocalController())
+	{
+		return nullptr;
+	}
+
+	GS_COUNT_ALLOCATIONS(STAT_GSHUDStatusBarWidgetsCreated, 1);
+	return CreateWidget<UGSFloatingStatusBarWidget>(PC, WidgetClass);
+}
+
+void UGSFloatingStatusBarSubsystem::ShowStatusBar(FGSFloatingStatusBarEntry& Entry)
+{
+	Entry.Widget = AcquireWidget(Entry.WidgetClass);
+	if (!Entry.Widget)
+	{
+		return;
+	}
+
+	Entry.Widget->OwningCharacter = Entry.Character.Get();
+	Entry.Widget->SetCharacterName(Entry.CharacterName);
+	UpdateStatusBarValues(Entry, true);
+
+	UWidgetComponent* WidgetComponent = Entry.WidgetComponent.Get();
+	WidgetComponent->SetWidget(Entry.Widget);
+	WidgetComponent->SetComponentTickEnabled(true);
+	WidgetComponent->SetVisibility(true, true);
+	Entry.bHidden = false;
+}
+
+void UGSFloatingStatusBarSubsystem::HideStatusBar(FGSFloatingStatusBarEntry& Entry)
+{
+	// Culled bars are hidden again on every update
+	if (Entry.bHidden)
+	{
+		return;
+	}
+
+	Entry.bHidden = true;
+
+	if (UWidgetComponent* WidgetComponent = Entry.WidgetComponent.Get())
+	{
+		// Nothing to draw, don't let it keep updating its screen position
+		WidgetComponent->SetVisibility(false, true);
+		WidgetComponent->SetComponentTickEnabled(false);
+
+		if (Entry.Widget)
+		{
+			WidgetComponent->SetWidget(nullptr);
+		}
+	}
+
+	if (Entry.Widget)
+	{
+		Entry.Widget->OwningCharacter = nullptr;
+		FreeWidgets.Add(Entry.Widget);
+		Entry.Widget = nullptr;
+	}
+}
@@ -2,4 +2,23 @@
 
 
 #include "UI/GSFloatingStatusBarWidget.h"
+#include "Characters/Abilities/AsyncTaskAttributeChanged.h"
+#include "UObject/UnrealType.h"
 
+void UGSFloatingStatusBarWidget::NativeConstruct()
+{
+	Super::NativeConstruct();
+
+	// Attribute listeners that a Blueprint subclass starts in Construct would update the bars on every change and
+	// bypass the subsystem's update rate and VisibleDelta. Silence them, the Blueprint still ends them in Destruct.
+	for (TFieldIterator<FObjectProperty> It(GetClass()); It; ++It)
+	{
+		if (It->PropertyClass->IsChildOf(UAsyncTaskAttributeChanged::StaticClass()))
+		{
+			if (UAsyncTaskAttributeChanged* AttributeChangedTask = Cast<UAsyncTaskAttributeChanged>(It->GetObjectPropertyValue_InContainer(this)))
+			{
+				AttributeChangedTask->StopListening();
+			}
+		}
+	}
+}
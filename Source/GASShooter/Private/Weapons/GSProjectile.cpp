@@ -2,7 +2,11 @@
 
 
 #include "Weapons/GSProjectile.h"
+#include "Engine/World.h"
 #include "GameFramework/ProjectileMovementComponent.h"
+#include "GSBlueprintFunctionLibrary.h"
+#include "UObject/UnrealType.h"
+#include "Weapons/GSProjectileSubsystem.h"
 
 // Sets default values
 AGSProjectile::AGSProjectile()
@@ -18,4 +22,129 @@ AGSProjectile::AGSProjectile()
 
 	//TODO change this to a better value
 	NetUpdateFrequency = 100.0f;
+
+	CollisionRadius = 10.0f;
+	MaxLifeSpan = 10.0f;
+	RandomSeed = 0;
+	ImpactRadius = 0.0f;
+	bLaunchThroughSubsystem = true;
+	bSimulatedBySubsystem = false;
+}
+
+void AGSProjectile::OnProjectileImpact_Implementation(const FHitResult& Hit)
+{
+	if (!ShouldApplyImpactEffects() || !EffectContainerSpec.HasValidEffects())
+	{
+		return;
+	}
+
+	TArray<FHitResult> HitResults;
+	TArray<AActor*> TargetActors;
+	if (ImpactRadius > 0.0f)
+	{
+		TArray<FOverlapResult> Overlaps;
+		GetWorld()->OverlapMultiByObjectType(Overlaps, Hit.Location, FQuat::Identity, FCollisionObjectQueryParams(ECC_Pawn),
+			FCollisionShape::MakeSphere(ImpactRadius));
+
+		for (const FOverlapResult& Overlap : Overlaps)
+		{
+			if (AActor* OverlapActor = Overlap.GetActor())
+			{
+				TargetActors.AddUnique(OverlapActor);
+			}
+		}
+	}
+	else if (Hit.GetActor())
+	{
+		HitResults.Add(Hit);
+	}
+
+	UGSBlueprintFunctionLibrary::AddTargetsToEffectContainerSpec(EffectContainerSpec, TArray<FGameplayAbilityTargetDataHandle>(), HitResults, TargetActors);
+	UGSBlueprintFunctionLibrary::ApplyExternalEffectContainerSpec(EffectContainerSpec);
+}
+
+bool AGSProjectile::ShouldApplyImpactEffects() const
+{
+	return GetNetMode() != NM_Client;
+}
+
+float AGSProjectile::GetInitialSpeed() const
+{
+	return ProjectileMovement ? ProjectileMovement->InitialSpeed : 0.0f;
+}
+
+float AGSProjectile::GetGravityScale() const
+{
+	return ProjectileMovement ? ProjectileMovement->ProjectileGravityScale : 0.0f;
+}
+
+void AGSProjectile::InitializeForSimulation(bool bReplicated)
+{
+	bSimulatedBySubsystem = true;
+	SetReplicates(bReplicated);
+	SetReplicateMovement(bReplicated);
+	SetActorEnableCollision(false);
+
+	if (ProjectileMovement)
+	{
+		ProjectileMovement->bAutoActivate = false;
+		ProjectileMovement->SetComponentTickEnabled(false);
+	}
+}
+
+void AGSProjectile::SetPooledActive(bool bActive)
+{
+	SetActorHiddenInGame(!bActive);
+
+	if (!bActive)
+	{
+		SetOwner(nullptr);
+		SetInstigator(nullptr);
+		EffectContainerSpec = FGSGameplayEffectContainerSpec();
+	}
+}
+
+void AGSProjectile::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (!bLaunchThroughSubsystem || bSimulatedBySubsystem || GetNetMode() == NM_Client)
+	{
+		return;
+	}
+
+	UGSProjectileSubsystem* ProjectileSubsystem = GetWorld()->GetSubsystem<UGSProjectileSubsystem>();
+	if (!ProjectileSubsystem)
+	{
+		return;
+	}
+
+	// Destroyed before it ever replicates, so clients only see the subsystem's projectile
+	const FGSGameplayEffectContainerSpec* SpawnContainerSpec = FindSpawnEffectContainerSpec();
+	AActor* InstigatorActor = GetInstigator() ? GetInstigator() : GetOwner();
+	ProjectileSubsystem->LaunchProjectile(GetClass(), GetActorLocation(), GetActorRotation(), InstigatorActor,
+		SpawnContainerSpec ? *SpawnContainerSpec : FGSGameplayEffectContainerSpec());
+	Destroy();
+}
+
+const FGSGameplayEffectContainerSpec* AGSProjectile::FindSpawnEffectContainerSpec() const
+{
+	if (EffectContainerSpec.HasValidEffects())
+	{
+		return &EffectContainerSpec;
+	}
+
+	for (TFieldIterator<FStructProperty> It(GetClass()); It; ++It)
+	{
+		if (It->Struct == FGSGameplayEffectContainerSpec::StaticStruct())
+		{
+			const FGSGameplayEffectContainerSpec* ContainerSpec = It->ContainerPtrToValuePtr<FGSGameplayEffectContainerSpec>(this);
+			if (ContainerSpec->HasValidEffects())
+			{
+				return ContainerSpec;
+			}
+		}
+	}
+
+	return nullptr;
 }
@@ -0,0 +1,186 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Weapons/GSProjectileReplicator.h"
+#include "Engine/World.h"
+#include "GameFramework/GameStateBase.h"
+#include "Net/UnrealNetwork.h"
+#include "Weapons/GSProjectileSubsystem.h"
+
+void FGSReplicatedProjectile::PreReplicatedRemove(const FGSReplicatedProjectileArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnProjectileRemoved(*this);
+	}
+}
+
+void FGSReplicatedProjectile::PostReplicatedAdd(const FGSReplicatedProjectileArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnProjectileAdded(*this);
+	}
+}
+
+void FGSReplicatedProjectile::PostReplicatedChange(const FGSReplicatedProjectileArray& InArraySerializer)
+{
+	if (InArraySerializer.Owner)
+	{
+		InArraySerializer.Owner->OnProjectileChanged(*this);
+	}
+}
+
+AGSProjectileReplicator::AGSProjectileReplicator()
+{
+	// Only ticks on the Server to drop old impacts
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.TickInterval = 0.25f;
+
+	bReplicates = true;
+	bAlwaysRelevant = true;
+	NetUpdateFrequency = 60.0f;
+	NetPriority = 2.0f;
+
+	ReplicatedProjectiles.Owner = this;
+	ImpactLingerTime = 1.0f;
+}
+
+void AGSProjectileReplicator::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+
+	DOREPLIFETIME(AGSProjectileReplicator, ReplicatedProjectiles);
+}
+
+void AGSProjectileReplicator::Tick(float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+
+	if (GetLocalRole() != ROLE_Authority)
+	{
+		return;
+	}
+
+	const float ServerTime = GetServerWorldTime();
+	const int32 NumRemoved = ReplicatedProjectiles.Projectiles.RemoveAll([ServerTime](const FGSReplicatedProjectile& Projectile)
+	{
+		return Projectile.RemoveTime > 0.0f && Projectile.RemoveTime <= ServerTime;
+	});
+
+	if (NumRemoved > 0)
+	{
+		ReplicatedProjectiles.MarkArrayDirty();
+	}
+}
+
+void AGSProjectileReplicator::AddProjectile(int32 ProjectileId, UClass* ProjectileClass, const FVector& Origin, const FVector& Velocity, int32 Seed, AActor* InstigatorActor)
+{
+	FGSReplicatedProjectile& Projectile = ReplicatedProjectiles.Projectiles.AddDefaulted_GetRef();
+	Projectile.ProjectileId = ProjectileId;
+	Projectile.ProjectileClass = ProjectileClass;
+	Projectile.Origin = Origin;
+	Projectile.Velocity = Velocity;
+	Projectile.LaunchServerTime = GetServerWorldTime();
+	Projectile.Seed = Seed;
+	Projectile.InstigatorActor = InstigatorActor;
+
+	ReplicatedProjectiles.MarkItemDirty(Projectile);
+}
+
+void AGSProjectileReplicator::NotifyImpact(int32 ProjectileId, const FHitResult& Hit)
+{
+	FGSReplicatedProjectile* Projectile = FindProjectile(ProjectileId);
+	if (!Projectile)
+	{
+		return;
+	}
+
+	// Kept around for a bit so that the change replicates before the removal
+	Projectile->bImpacted = true;
+	Projectile->ImpactLocation = Hit.Location;
+	Projectile->ImpactNormal = Hit.ImpactNormal;
+	Projectile->RemoveTime = GetServerWorldTime() + ImpactLingerTime;
+
+	ReplicatedProjectiles.MarkItemDirty(*Projectile);
+}
+
+void AGSProjectileReplicator::NotifyExpired(int32 ProjectileId)
+{
+	const int32 Index = ReplicatedProjectiles.Projectiles.IndexOfByPredicate([ProjectileId](const FGSReplicatedProjectile& Projectile)
+	{
+		return Projectile.ProjectileId == ProjectileId;
+	});
+
+	if (Index != INDEX_NONE)
+	{
+		ReplicatedProjectiles.Projectiles.RemoveAtSwap(Index);
+		ReplicatedProjectiles.MarkArrayDirty();
+	}
+}
+
+FGSReplicatedProjectile* AGSProjectileReplicator::FindProjectile(int32 ProjectileId)
+{
+	return ReplicatedProjectiles.Projectiles.FindByPredicate([ProjectileId](const FGSReplicatedProjectile& Projectile)
+	{
+		return Projectile.ProjectileId == ProjectileId;
+	});
+}
+
+float AGSProjectileReplicator::GetServerWorldTime() const
+{
+	const AGameStateBase* GameState = GetWorld()->GetGameState();
+	return GameState ? GameState->GetServerWorldTimeSeconds() : GetWorld()->GetTimeSeconds();
+}
+
+UGSProjectileSubsystem* AGSProjectileReplicator::GetProjectileSubsystem() const
+{
+	UWorld* World = GetWorld();
+	return World ? World->GetSubsystem<UGSProjectileSubsystem>() : nullptr;
+}
+
+void AGSProjectileReplicator::OnProjectileAdded(const FGSReplicatedProjectile& Projectile)
+{
+	UGSProjectileSubsystem* ProjectileSubsystem = GetProjectileSubsystem();
+	if (!ProjectileSubsystem)
+	{
+		return;
+	}
+
+	ProjectileSubsystem->SimulateReplicatedProjectile(Projectile.ProjectileId, Projectile.ProjectileClass, Projectile.Origin, Projectile.Velocity,
+		GetServerWorldTime() - Projectile.LaunchServerTime, Projectile.Seed, Projectile.InstigatorActor);
+
+	// Short lived projectiles can hit before their launch was ever sent
+	if (Projectile.bImpacted)
+	{
+		OnProjectileChanged(Projectile);
+	}
+}
+
+void AGSProjectileReplicator::OnProjectileChanged(const FGSReplicatedProjectile& Projectile)
+{
+	UGSProjectileSubsystem* ProjectileSubsystem = GetProjectileSubsystem();
+	if (!ProjectileSubsystem || !Projectile.bImpacted)
+	{
+		return;
+	}
+
+	FHitResult Hit;
+	Hit.bBlockingHit = true;
+	Hit.Location = Projectile.ImpactLocation;
+	Hit.ImpactPoint = Projectile.ImpactLocation;
+	Hit.Normal = Projectile.ImpactNormal;
+	Hit.ImpactNormal = Projectile.ImpactNormal;
+	Hit.TraceStart = Projectile.ImpactLocation - Projectile.Velocity.GetSafeNormal();
+	Hit.TraceEnd = Projectile.ImpactLocation;
+
+	ProjectileSubsystem->ReconcileImpact(Projectile.ProjectileId, Hit);
+}
+
+void AGSProjectileReplicator::OnProjectileRemoved(const FGSReplicatedProjectile& Projectile)
+{
+	if (UGSProjectileSubsystem* ProjectileSubsystem = GetProjectileSubsystem())
+	{
+		ProjectileSubsystem->StopProjectile(Projectile.ProjectileId);
+	}
+}
@@ -0,0 +1,609 @@
+// Copyright 2020 Dan Kestranek.
+
+
+#include "Weapons/GSProjectileSubsystem.h"
+#include "Async/ParallelFor.h"
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/NetDriver.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "GASShooter/GASShooter.h"
+#include "GSStats.h"
+#include "Weapons/GSProjectile.h"
+#include "Weapons/GSProjectileReplicator.h"
+
+static TAutoConsoleVariable<int32> CVarProjectileParallelThreshold(
+	TEXT("GS.Projectiles.ParallelThreshold"),
+	64,
+	TEXT("Number of simulated projectiles at which integration is split across worker threads")
+);
+
+static TAutoConsoleVariable<float> CVarProjectileVisualCullDistance(
+	TEXT("GS.Projectiles.VisualCullDistance"),
+	15000.0f,
+	TEXT("Distance in cm from the local view beyond which simulated projectiles don't get a visual Actor")
+);
+
+static TAutoConsoleVariable<int32> CVarProjectileReplicationMode(
+	TEXT("GS.Projectiles.ReplicationMode"),
+	0,
+	TEXT("How the Server replicates simulated projectiles. 0: launch and impact events through AGSProjectileReplicator. 1: one replicated Actor per projectile, for comparison.")
+);
+
+static int32 GetProjectileReplicationMode()
+{
+	return FMath::Clamp(CVarProjectileReplicationMode.GetValueOnGameThread(), 0, 1);
+}
+
+#if !UE_BUILD_SHIPPING
+namespace GSProjectileReplicationStats
+{
+	struct FReplicationModeStats
+	{
+		int32 NumLaunched = 0;
+		uint64 OutBytes = 0;
+		double InFlightSeconds = 0.0;
+	};
+
+	static FReplicationModeStats ModeStats[2];
+	static uint32 LastOutTotalBytes = 0;
+
+	static void RecordLaunch(const UWorld* World, bool bFirstInFlight)
+	{
+		ModeStats[GetProjectileReplicationMode()].NumLaunched++;
+
+		// Don't count the traffic from while nothing was in flight
+		const UNetDriver* NetDriver = World->GetNetDriver();
+		if (bFirstInFlight && NetDriver)
+		{
+			LastOutTotalBytes = NetDriver->OutTotalBytes;
+		}
+	}
+
+	static void RecordInFlightFrame(const UWorld* World, float DeltaTime)
+	{
+		const UNetDriver* NetDriver = World->GetNetDriver();
+		if (!NetDriver)
+		{
+			return;
+		}
+
+		FReplicationModeStats& Stats = ModeStats[GetProjectileReplicationMode()];
+		Stats.OutBytes += NetDriver->OutTotalBytes - LastOutTotalBytes;
+		Stats.InFlightSeconds += DeltaTime;
+		LastOutTotalBytes = NetDriver->OutTotalBytes;
+	}
+
+	static void Reset()
+	{
+		for (FReplicationModeStats& Stats : ModeStats)
+		{
+			Stats = FReplicationModeStats();
+		}
+	}
+
+	static void Report()
+	{
+		static const TCHAR* ModeNames[] = { TEXT("Events"), TEXT("Actors") };
+
+		UE_LOG(LogTemp, Log, TEXT("%s Server out bytes while projectiles were in flight. Includes all other traffic, so compare runs of the same scenario."), *FString(__FUNCTION__));
+
+		for (int32 Mode = 0; Mode < 2; Mode++)
+		{
+			const FReplicationModeStats& Stats = ModeStats[Mode];
+			UE_LOG(LogTemp, Log, TEXT("%s %s Launched: %d Bytes: %llu Bytes/projectile: %.1f Bytes/s in flight: %.1f"), *FString(__FUNCTION__), ModeNames[Mode],
+				Stats.NumLaunched, Stats.OutBytes, Stats.NumLaunched > 0 ? static_cast<double>(Stats.OutBytes) / Stats.NumLaunched : 0.0,
+				Stats.InFlightSeconds > 0.0 ? Stats.OutBytes / Stats.InFlightSeconds : 0.0);
+		}
+	}
+}
+
+static FAutoConsoleCommand ProjectileReplicationReportCommand(
+	TEXT("GS.Projectiles.ReplicationReport"),
+	TEXT("Logs Server out bytes per projectile for each GS.Projectiles.ReplicationMode used since the last reset"),
+	FConsoleCommandDelegate::CreateStatic(&GSProjectileReplicationStats::Report)
+);
+
+static FAutoConsoleCommand ProjectileReplicationResetCommand(
+	TEXT("GS.Projectiles.ReplicationReset"),
+	TEXT("Clears the counts used by GS.Projectiles.ReplicationReport"),
+	FConsoleCommandDelegate::CreateStatic(&GSProjectileReplicationStats::Reset)
+);
+#endif
+
+int32 FGSProjectileArrays::Add(int32 Id, UClass* ProjectileClass, const FVector& Location, const FVector& Velocity, float InGravityZ, float Radius, float LifeSpan,
+	int32 Seed, AActor* Instigator, const FGSGameplayEffectContainerSpec& EffectContainerSpec)
+{
+	Ids.Add(Id);
+	Locations.Add(Location);
+	PreviousLocations.Add(Location);
+	Velocities.Add(Velocity);
+	GravityZ.Add(InGravityZ);
+	Radii.Add(Radius);
+	LifeRemaining.Add(LifeSpan);
+	Seeds.Add(Seed);
+	Instigators.Add(Instigator);
+	EffectContainerSpecs.Add(EffectContainerSpec);
+	Classes.Add(ProjectileClass);
+	return Visuals.Add(nullptr);
+}
+
+void FGSProjectileArrays::RemoveAtSwap(int32 Index)
+{
+	Ids.RemoveAtSwap(Index, 1, false);
+	Locations.RemoveAtSwap(Index, 1, false);
+	PreviousLocations.RemoveAtSwap(Index, 1, false);
+	Velocities.RemoveAtSwap(Index, 1, false);
+	GravityZ.RemoveAtSwap(Index, 1, false);
+	Radii.RemoveAtSwap(Index, 1, false);
+	LifeRemaining.RemoveAtSwap(Index, 1, false);
+	Seeds.RemoveAtSwap(Index, 1, false);
+	Instigators.RemoveAtSwap(Index, 1, false);
+	EffectContainerSpecs.RemoveAtSwap(Index, 1, false);
+	Classes.RemoveAtSwap(Index, 1, false);
+	Visuals.RemoveAtSwap(Index, 1, false);
+}
+
+void FGSProjectileArrays::Empty()
+{
+	Ids.Empty();
+	Locations.Empty();
+	PreviousLocations.Empty();
+	Velocities.Empty();
+	GravityZ.Empty();
+	Radii.Empty();
+	LifeRemaining.Empty();
+	Seeds.Empty();
+	Instigators.Empty();
+	EffectContainerSpecs.Empty();
+	Classes.Empty();
+	Visuals.Empty();
+}
+
+UGSProjectileSubsystem::UGSProjectileSubsystem()
+{
+	Replicator = nullptr;
+	NextProjectileId = 0;
+}
+
+void UGSProjectileSubsystem::Deinitialize()
+{
+	// The world is tearing down and will destroy the visual Actors and the replicator
+	Projectiles.Empty();
+	VisualPools.Empty();
+	Replicator = nullptr;
+
+	Super::Deinitialize();
+}
+
+void UGSProjectileSubsystem::Tick(float DeltaTime)
+{
+#if !UE_BUILD_SHIPPING
+	if (GetWorld()->GetNetMode() == NM_DedicatedServer || GetWorld()->GetNetMode() == NM_ListenServer)
+	{
+		GSProjectileReplicationStats::RecordInFlightFrame(GetWorld(), DeltaTime);
+	}
+#endif
+
+	Integrate(DeltaTime);
+	SweepProjectiles();
+}
+
+bool UGSProjectileSubsystem::IsTickable() const
+{
+	return !HasAnyFlags(RF_ClassDefaultObject) && GetWorld() && Projectiles.Num() > 0;
+}
+
+TStatId UGSProjectileSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGSProjectileSubsystem, STATGROUP_Tickables);
+}
+
+UWorld* UGSProjectileSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+int32 UGSProjectileSubsystem::LaunchProjectile(TSubclassOf<AGSProjectile> ProjectileClass, FVector Location, FRotator Rotation, AActor* InstigatorActor, const FGSGameplayEffectContainerSpec& EffectContainerSpec)
+{
+	if (!ProjectileClass)
+	{
+		return INDEX_NONE;
+	}
+
+	const ENetMode NetMode = GetWorld()->GetNetMode();
+	const bool bIsServer = NetMode == NM_DedicatedServer || NetMode == NM_ListenServer;
+	const bool bReplicateAsActor = bIsServer && GetProjectileReplicationMode() == 1;
+
+	// Client only launches are cosmetic and get negative ids so that they never clash with the Server's
+	const int32 Id = NetMode == NM_Client ? -(++NextProjectileId) : NextProjectileId++;
+	const int32 Seed = FMath::Rand();
+
+	FVector Velocity = Rotation.Vector() * ProjectileClass->GetDefaultObject<AGSProjectile>()->GetInitialSpeed();
+	if (bIsServer && !bReplicateAsActor)
+	{
+		// Simulate exactly what clients get after quantization
+		Location = Location.GridSnap(1.0f);
+		Velocity = Velocity.GridSnap(1.0f);
+	}
+
+	const int32 Index = AddProjectile(Id, ProjectileClass, Location, Velocity, Seed, InstigatorActor, EffectContainerSpec);
+
+#if !UE_BUILD_SHIPPING
+	if (bIsServer)
+	{
+		GSProjectileReplicationStats::RecordLaunch(GetWorld(), Projectiles.Num() == 1);
+	}
+#endif
+
+	if (bReplicateAsActor)
+	{
+		Projectiles.Visuals[Index] = SpawnReplicatedVisual(Index, Location, Rotation);
+		return Id;
+	}
+
+	if (bIsServer)
+	{
+		if (AGSProjectileReplicator* ProjectileReplicator = GetReplicator())
+		{
+			ProjectileReplicator->AddProjectile(Id, ProjectileClass, Location, Velocity, Seed, InstigatorActor);
+		}
+	}
+
+	FVector ViewLocation;
+	const bool bHasViewer = GetLocalViewLocation(ViewLocation);
+	if (ShouldMaterializeVisual(Location, ViewLocation, bHasViewer))
+	{
+		Projectiles.Visuals[Index] = AcquireVisual(Index, Location, Rotation);
+	}
+
+	return Id;
+}
+
+int32 UGSProjectileSubsystem::GetNumProjectiles() const
+{
+	return Projectiles.Num();
+}
+
+void UGSProjectileSubsystem::SimulateReplicatedProjectile(int32 ProjectileId, UClass* ProjectileClass, const FVector& Origin, const FVector& Velocity, float ElapsedTime, int32 Seed, AActor* InstigatorActor)
+{
+	if (!ProjectileClass || Projectiles.Ids.Contains(ProjectileId))
+	{
+		return;
+	}
+
+	const AGSProjectile* ProjectileCDO = ProjectileClass->GetDefaultObject<AGSProjectile>();
+	ElapsedTime = FMath::Max(ElapsedTime, 0.0f);
+	if (ElapsedTime >= ProjectileCDO->MaxLifeSpan)
+	{
+		return;
+	}
+
+	// Fast forward to where the projectile is on the Server now. This part isn't swept, the Server reports anything it
+	// hit on the way.
+	const float GravityZ = GetWorld()->GetGravityZ() * ProjectileCDO->GetGravityScale();
+	const FVector Location = Origin + Velocity * ElapsedTime + FVector(0.0f, 0.0f, 0.5f * GravityZ * FMath::Square(ElapsedTime));
+	const FVector CurrentVelocity = Velocity + FVector(0.0f, 0.0f, GravityZ * ElapsedTime);
+
+	const int32 Index = AddProjectile(ProjectileId, ProjectileClass, Location, CurrentVelocity, Seed, InstigatorActor, FGSGameplayEffectContainerSpec());
+	Projectiles.LifeRemaining[Index] -= ElapsedTime;
+
+	FVector ViewLocation;
+	const bool bHasViewer = GetLocalViewLocation(ViewLocation);
+	if (ShouldMaterializeVisual(Location, ViewLocation, bHasViewer))
+	{
+		Projectiles.Visuals[Index] = AcquireVisual(Index, Location, CurrentVelocity.Rotation());
+	}
+}
+
+void UGSProjectileSubsystem::ReconcileImpact(int32 ProjectileId, const FHitResult& Hit)
+{
+	// Not found if we already showed a predicted impact
+	const int32 Index = Projectiles.Ids.IndexOfByKey(ProjectileId);
+	if (Index != INDEX_NONE)
+	{
+		ResolveImpact(Index, Hit);
+	}
+}
+
+void UGSProjectileSubsystem::StopProjectile(int32 ProjectileId)
+{
+	const int32 Index = Projectiles.Ids.IndexOfByKey(ProjectileId);
+	if (Index != INDEX_NONE)
+	{
+		ReleaseVisual(Projectiles.Visuals[Index]);
+		Projectiles.RemoveAtSwap(Index);
+	}
+}
+
+AGSProjectileReplicator* UGSProjectileSubsystem::GetReplicator()
+{
+	if (!IsValid(Replicator))
+	{
+		FActorSpawnParameters SpawnParameters;
+		SpawnParameters.ObjectFlags |= RF_Transient;
+		Replicator = GetWorld()->SpawnActor<AGSProjectileReplicator>(SpawnParameters);
+	}
+
+	return Replicator;
+}
+
+int32 UGSProjectileSubsystem::AddProjectile(int32 ProjectileId, UClass* ProjectileClass, const FVector& Location, const FVector& Velocity, int32 Seed,
+	AActor* InstigatorActor, const FGSGameplayEffectContainerSpec& EffectContainerSpec)
+{
+	const AGSProjectile* ProjectileCDO = ProjectileClass->GetDefaultObject<AGSProjectile>();
+	const float GravityZ = GetWorld()->GetGravityZ() * ProjectileCDO->GetGravityScale();
+
+	return Projectiles.Add(ProjectileId, ProjectileClass, Location, Velocity, GravityZ, ProjectileCDO->CollisionRadius, ProjectileCDO->MaxLifeSpan,
+		Seed, InstigatorActor, EffectContainerSpec);
+}
+
+void UGSProjectileSubsystem::Integrate(float DeltaTime)
+{
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSProjectileIntegrate);
+
+	FVector* Locations = Projectiles.Locations.GetData();
+	FVector* PreviousLocations = Projectiles.PreviousLocations.GetData();
+	FVector* Velocities = Projectiles.Velocities.GetData();
+	const float* GravityZ = Projectiles.GravityZ.GetData();
+	float* LifeRemaining = Projectiles.LifeRemaining.GetData();
+
+	auto IntegrateProjectile = [=](int32 i)
+	{
+		PreviousLocations[i] = Locations[i];
+		Velocities[i].Z += GravityZ[i] * DeltaTime;
+		Locations[i] += Velocities[i] * DeltaTime;
+		LifeRemaining[i] -= DeltaTime;
+	};
+
+	const int32 NumProjectiles = Projectiles.Num();
+	if (NumProjectiles >= CVarProjectileParallelThreshold.GetValueOnGameThread())
+	{
+		ParallelFor(NumProjectiles, IntegrateProjectile);
+	}
+	else
+	{
+		for (int32 i = 0; i < NumProjectiles; i++)
+		{
+			IntegrateProjectile(i);
+		}
+	}
+}
+
+void UGSProjectileSubsystem::SweepProjectiles()
+{
+	GS_SCOPE_CYCLE_COUNTER(STAT_GSProjectileSweep);
+
+	UWorld* World = GetWorld();
+
+	FVector ViewLocation;
+	const bool bHasViewer = GetLocalViewLocation(ViewLocation);
+
+	// Backwards so that removing swaps in a projectile we already handled
+	for (int32 i = Projectiles.Num() - 1; i >= 0; i--)
+	{
+		if (Projectiles.LifeRemaining[i] <= 0.0f)
+		{
+			if (Replicator)
+			{
+				Replicator->NotifyExpired(Projectiles.Ids[i]);
+			}
+
+			ReleaseVisual(Projectiles.Visuals[i]);
+			Projectiles.RemoveAtSwap(i);
+			continue;
+		}
+
+		const FVector& Location = Projectiles.Locations[i];
+
+		FCollisionQueryParams Params(SCENE_QUERY_STAT(GSProjectileSweep), false, Projectiles.Instigators[i].Get());
+		FHitResult Hit;
+		if (World->SweepSingleByChannel(Hit, Projectiles.PreviousLocations[i], Location, FQuat::Identity, COLLISION_PROJECTILE,
+			FCollisionShape::MakeSphere(Projectiles.Radii[i]), Params))
+		{
+			ResolveImpact(i, Hit);
+			continue;
+		}
+
+		AGSProjectile*& Visual = Projectiles.Visuals[i];
+		const FRotator Rotation = Projectiles.Velocities[i].Rotation();
+		if (Visual && Visual->GetIsReplicated())
+		{
+			// Replicated Actors have to follow the simulation everywhere so that clients can see them
+			Visual->SetActorLocationAndRotation(Location, Rotation);
+		}
+		else if (ShouldMaterializeVisual(Location, ViewLocation, bHasViewer))
+		{
+			if (Visual)
+			{
+				Visual->SetActorLocationAndRotation(Location, Rotation);
+			}
+			else
+			{
+				Visual = AcquireVisual(i, Location, Rotation);
+			}
+		}
+		else if (Visual)
+		{
+			ReleaseVisual(Visual);
+			Visual = nullptr;
+		}
+	}
+}
+
+void UGSProjectileSubsystem::ResolveImpact(int32 Index, const FHitResult& Hit)
+{
+	// The impact logic lives on the Actor. Without a local viewer nobody sees it, so use the hidden handler instead of
+	// growing the visual pool.
+	AGSProjectile* Projectile = Projectiles.Visuals[Index];
+	FVector ViewLocation;
+	const bool bUseImpactHandler = !Projectile && !GetLocalViewLocation(ViewLocation);
+	if (!Projectile)
+	{
+		const FRotator Rotation = (Hit.TraceEnd - Hit.TraceStart).Rotation();
+		Projectile = bUseImpactHandler ? GetImpactHandler(Index, Hit.Location, Rotation) : AcquireVisual(Index, Hit.Location, Rotation);
+	}
+
+	const int32 Id = Projectiles.Ids[Index];
+	AActor* InstigatorActor = Projectiles.Instigators[Index].Get();
+	const FGSGameplayEffectContainerSpec EffectContainerSpec = Projectiles.EffectContainerSpecs[Index];
+
+	// Remove before running the impact logic in case it launches more projectiles
+	Projectiles.RemoveAtSwap(Index);
+
+	if (Replicator)
+	{
+		Replicator->NotifyImpact(Id, Hit);
+	}
+
+	if (Projectile)
+	{
+		Projectile->SetActorLocation(Hit.Location);
+		Projectile->SetOwner(InstigatorActor);
+		Projectile->SetInstigator(Cast<APawn>(InstigatorActor));
+		Projectile->EffectContainerSpec = EffectContainerSpec;
+		Projectile->OnProjectileImpact(Hit);
+
+		if (bUseImpactHandler)
+		{
+			Projectile->SetPooledActive(false);
+		}
+		else
+		{
+			ReleaseVisual(Projectile);
+		}
+	}
+
+	OnProjectileImpact.Broadcast(Id, Hit);
+}
+
+bool UGSProjectileSubsystem::ShouldMaterializeVisual(const FVector& Location, const FVector& ViewLocation, bool bHasViewer) const
+{
+	const float CullDistance = CVarProjectileVisualCullDistance.GetValueOnGameThread();
+	return bHasViewer && FVector::DistSquared(Location, ViewLocation) <= FMath::Square(CullDistance);
+}
+
+bool UGSProjectileSubsystem::GetLocalViewLocation(FVector& OutViewLocation) const
+{
+	// Dedicated servers have nobody to show projectiles to
+	const APlayerController* PC = GetWorld()->GetFirstPlayerController();
+	if (!PC || !PC->IsLocalController() || !PC->PlayerCameraManager)
+	{
+		return false;
+	}
+
+	OutViewLocation = PC->PlayerCameraManager->GetCameraLocation();
+	return true;
+}
+
+AGSProjectile* UGSProjectileSubsystem::AcquireVisual(int32 Index, const FVector& Location, const FRotator& Rotation)
+{
+	UClass* ProjectileClass = Projectiles.Classes[Index];
+	FGSProjectileVisualPool& Pool = VisualPools.FindOrAdd(ProjectileClass);
+
+	AGSProjectile* Projectile = nullptr;
+	while (!Projectile && Pool.FreeProjectiles.Num() > 0)
+	{
+		// Something else may have destroyed it while it was in the pool
+		Projectile = Pool.FreeProjectiles.Pop(false);
+		if (IsValid(Projectile))
+		{
+			Projectile->SetActorLocationAndRotation(Location, Rotation);
+			Projectile->SetPooledActive(true);
+		}
+		else
+		{
+			Projectile = nullptr;
+		}
+	}
+
+	if (!Projectile)
+	{
+		Projectile = SpawnLocalProjectile(ProjectileClass, Location, Rotation);
+		if (!Projectile)
+		{
+			return nullptr;
+		}
+
+		GS_COUNT_ALLOCATIONS(STAT_GSProjectileVisualsSpawned, 1);
+	}
+
+	Projectile->RandomSeed = Projectiles.Seeds[Index];
+	return Projectile;
+}
+
+AGSProjectile* UGSProjectileSubsystem::GetImpactHandler(int32 Index, const FVector& Location, const FRotator& Rotation)
+{
+	UClass* ProjectileClass = Projectiles.Classes[Index];
+	FGSProjectileVisualPool& Pool = VisualPools.FindOrAdd(ProjectileClass);
+
+	if (IsValid(Pool.ImpactHandler))
+	{
+		Pool.ImpactHandler->SetActorLocationAndRotation(Location, Rotation);
+	}
+	else
+	{
+		Pool.ImpactHandler = SpawnLocalProjectile(ProjectileClass, Location, Rotation);
+		if (!Pool.ImpactHandler)
+		{
+			return nullptr;
+		}
+
+		Pool.ImpactHandler->SetPooledActive(false);
+	}
+
+	Pool.ImpactHandler->RandomSeed = Projectiles.Seeds[Index];
+	return Pool.ImpactHandler;
+}
+
+AGSProjectile* UGSProjectileSubsystem::SpawnLocalProjectile(UClass* ProjectileClass, const FVector& Location, const FRotator& Rotation)
+{
+	const FTransform SpawnTransform(Rotation, Location);
+	AGSProjectile* Projectile = GetWorld()->SpawnActorDeferred<AGSProjectile>(ProjectileClass, SpawnTransform, nullptr, nullptr,
+		ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Projectile)
+	{
+		return nullptr;
+	}
+
+	Projectile->InitializeForSimulation(false);
+	Projectile->FinishSpawning(SpawnTransform);
+	return Projectile;
+}
+
+AGSProjectile* UGSProjectileSubsystem::SpawnReplicatedVisual(int32 Index, const FVector& Location, const FRotator& Rotation)
+{
+	const FTransform SpawnTransform(Rotation, Location);
+	AGSProjectile* Projectile = GetWorld()->SpawnActorDeferred<AGSProjectile>(Projectiles.Classes[Index], SpawnTransform, Projectiles.Instigators[Index].Get(),
+		Cast<APawn>(Projectiles.Instigators[Index].Get()), ESpawnActorCollisionHandlingMethod::AlwaysSpawn);
+	if (!Projectile)
+	{
+		return nullptr;
+	}
+
+	// Moved by us, but otherwise replicated exactly like a directly spawned projectile
+	Projectile->InitializeForSimulation(true);
+	Projectile->RandomSeed = Projectiles.Seeds[Index];
+	Projectile->FinishSpawning(SpawnTransform);
+	GS_COUNT_ALLOCATIONS(STAT_GSProjectileVisualsSpawned, 1);
+
+	return Projectile;
+}
+
+void UGSProjectileSubsystem::ReleaseVisual(AGSProjectile* Projectile)
+{
+	if (!IsValid(Projectile))
+	{
+		return;
+	}
+
+	// Replicated ones can't be pooled, clients would keep seeing them
+	if (Projectile->GetIsReplicated())
+	{
+		Projectile->Destroy();
+		return;
+	}
+
+	Projectile->SetPooledActive(false);
+	VisualPools.FindOrAdd(Projectile->GetClass()).FreeProjectiles.AddUnique(Projectile);
+}
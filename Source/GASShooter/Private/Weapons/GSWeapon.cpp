@@ -7,6 +7,7 @@
 #include "Characters/Abilities/GSGameplayAbility.h"
 #include "Characters/Abilities/GSGATA_LineTrace.h"
 #include "Characters/Abilities/GSGATA_SphereTrace.h"
+#include "Characters/Abilities/GSTargetActorPoolSubsystem.h"
 #include "Characters/Heroes/GSHeroCharacter.h"
 #include "Components/CapsuleComponent.h"
 #include "Components/SkeletalMeshComponent.h"
@@ -22,7 +23,13 @@ AGSWeapon::AGSWeapon()
 
 	bReplicates = true;
 	bNetUseOwnerRelevancy = true;
-	NetUpdateFrequency = 100.0f; // Set this to a value that's appropriate for your game
+	EquippedNetUpdateFrequency = 100.0f; // Set this to a value that's appropriate for your game
+	EquippedMinNetUpdateFrequency = 10.0f;
+	HolsteredNetUpdateFrequency = 10.0f;
+	DroppedNetUpdateFrequency = 1.0f;
+	NetUpdateFrequency = EquippedNetUpdateFrequency;
+	MinNetUpdateFrequency = EquippedMinNetUpdateFrequency;
+	NetState = EGSWeaponNetState::Equipped; // BeginPlay and SetOwningCharacter() pick the real state
 	bSpawnWithCollision = true;
 	PrimaryClipAmmo = 0;
 	MaxPrimaryClipAmmo = 0;
@@ -119,6 +126,12 @@ void AGSWeapon::SetOwningCharacter(AGSHeroCharacter* InOwningCharacter)
 			WeaponMesh3P->CastShadow = false;
 			WeaponMesh3P->SetVisibility(true, true);
 			WeaponMesh3P->SetVisibility(false, true);
+
+			SetNetState(EGSWeaponNetState::Holstered);
+		}
+		else
+		{
+			SetNetState(EGSWeaponNetState::Equipped);
 		}
 	}
 	else
@@ -126,6 +139,8 @@ void AGSWeapon::SetOwningCharacter(AGSHeroCharacter* InOwningCharacter)
 		AbilitySystemComponent = nullptr;
 		SetOwner(nullptr);
 		DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+
+		SetNetState(EGSWeaponNetState::Dropped);
 	}
 }
 
@@ -147,6 +162,8 @@ void AGSWeapon::Equip()
 		return;
 	}
 
+	SetNetState(EGSWeaponNetState::Equipped);
+
 	FName AttachPoint = OwningCharacter->GetWeaponAttachPoint();
 
 	if (WeaponMesh1P)
@@ -187,11 +204,16 @@ void AGSWeapon::Equip()
 
 void AGSWeapon::UnEquip()
 {
+	// Give the TargetActors back to the pool for the next weapon that gets equipped
+	ReturnTargetActors();
+
 	if (OwningCharacter == nullptr)
 	{
 		return;
 	}
 
+	SetNetState(EGSWeaponNetState::Holstered);
+
 	// Necessary to detach so that when toggling perspective all meshes attached won't become visible.
 
 	WeaponMesh1P->DetachFromComponent(FDetachmentTransformRules::KeepRelativeTransform);
@@ -272,11 +294,13 @@ void AGSWeapon::ResetWeapon()
 
 void AGSWeapon::OnDropped_Implementation(FVector NewLocation)
 {
+	ReturnTargetActors();
 	SetOwningCharacter(nullptr);
 	ResetWeapon();
 
 	SetActorLocation(NewLocation);
 	CollisionComp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+	SetNetState(EGSWeaponNetState::Dropped);
 
 	if (WeaponMesh1P)
 	{
@@ -322,6 +346,7 @@ void AGSWeapon::SetPrimaryClipAmmo(int32 NewPrimaryClipAmmo)
 {
 	int32 OldPrimaryClipAmmo = PrimaryClipAmmo;
 	PrimaryClipAmmo = NewPrimaryClipAmmo;
+	FlushAmmoNetDormancy();
 	OnPrimaryClipAmmoChanged.Broadcast(OldPrimaryClipAmmo, PrimaryClipAmmo);
 }
 
@@ -329,6 +354,7 @@ void AGSWeapon::SetMaxPrimaryClipAmmo(int32 NewMaxPrimaryClipAmmo)
 {
 	int32 OldMaxPrimaryClipAmmo = MaxPrimaryClipAmmo;
 	MaxPrimaryClipAmmo = NewMaxPrimaryClipAmmo;
+	FlushAmmoNetDormancy();
 	OnMaxPrimaryClipAmmoChanged.Broadcast(OldMaxPrimaryClipAmmo, MaxPrimaryClipAmmo);
 }
 
@@ -336,6 +362,7 @@ void AGSWeapon::SetSecondaryClipAmmo(int32 NewSecondaryClipAmmo)
 {
 	int32 OldSecondaryClipAmmo = SecondaryClipAmmo;
 	SecondaryClipAmmo = NewSecondaryClipAmmo;
+	FlushAmmoNetDormancy();
 	OnSecondaryClipAmmoChanged.Broadcast(OldSecondaryClipAmmo, SecondaryClipAmmo);
 }
 
@@ -343,6 +370,7 @@ void AGSWeapon::SetMaxSecondaryClipAmmo(int32 NewMaxSecondaryClipAmmo)
 {
 	int32 OldMaxSecondaryClipAmmo = MaxSecondaryClipAmmo;
 	MaxSecondaryClipAmmo = NewMaxSecondaryClipAmmo;
+	FlushAmmoNetDormancy();
 	OnMaxSecondaryClipAmmoChanged.Broadcast(OldMaxSecondaryClipAmmo, MaxSecondaryClipAmmo);
 }
 
@@ -383,8 +411,11 @@ AGSGATA_LineTrace* AGSWeapon::GetLineTraceTargetActor()
 		return LineTraceTargetActor;
 	}
 
-	LineTraceTargetActor = GetWorld()->SpawnActor<AGSGATA_LineTrace>();
-	LineTraceTargetActor->SetOwner(this);
+	if (UGSTargetActorPoolSubsystem* TargetActorPool = GetWorld()->GetSubsystem<UGSTargetActorPoolSubsystem>())
+	{
+		LineTraceTargetActor = TargetActorPool->LeaseTargetActor<AGSGATA_LineTrace>(this);
+	}
+
 	return LineTraceTargetActor;
 }
 
@@ -395,11 +426,75 @@ AGSGATA_SphereTrace* AGSWeapon::GetSphereTraceTargetActor()
 		return SphereTraceTargetActor;
 	}
 
-	SphereTraceTargetActor = GetWorld()->SpawnActor<AGSGATA_SphereTrace>();
-	SphereTraceTargetActor->SetOwner(this);
+	if (UGSTargetActorPoolSubsystem* TargetActorPool = GetWorld()->GetSubsystem<UGSTargetActorPoolSubsystem>())
+	{
+		SphereTraceTargetActor = TargetActorPool->LeaseTargetActor<AGSGATA_SphereTrace>(this);
+	}
+
 	return SphereTraceTargetActor;
 }
 
+void AGSWeapon::ReturnTargetActors()
+{
+	UGSTargetActorPoolSubsystem* TargetActorPool = GetWorld() ? GetWorld()->GetSubsystem<UGSTargetActorPoolSubsystem>() : nullptr;
+	if (!TargetActorPool)
+	{
+		return;
+	}
+
+	if (LineTraceTargetActor)
+	{
+		TargetActorPool->ReturnTargetActor(LineTraceTargetActor);
+		LineTraceTargetActor = nullptr;
+	}
+
+	if (SphereTraceTargetActor)
+	{
+		TargetActorPool->ReturnTargetActor(SphereTraceTargetActor);
+		SphereTraceTargetActor = nullptr;
+	}
+}
+
+void AGSWeapon::SetNetState(EGSWeaponNetState NewNetState)
+{
+	if (GetLocalRole() != ROLE_Authority || NetState == NewNetState)
+	{
+		return;
+	}
+
+	NetState = NewNetState;
+
+	switch (NetState)
+	{
+	case EGSWeaponNetState::Equipped:
+		NetUpdateFrequency = EquippedNetUpdateFrequency;
+		MinNetUpdateFrequency = EquippedMinNetUpdateFrequency;
+		SetNetDormancy(DORM_Awake);
+		break;
+	case EGSWeaponNetState::Holstered:
+		NetUpdateFrequency = HolsteredNetUpdateFrequency;
+		MinNetUpdateFrequency = HolsteredNetUpdateFrequency;
+		SetNetDormancy(DORM_DormantAll);
+		break;
+	case EGSWeaponNetState::Dropped:
+		NetUpdateFrequency = DroppedNetUpdateFrequency;
+		MinNetUpdateFrequency = DroppedNetUpdateFrequency;
+		SetNetDormancy(DORM_DormantAll);
+		break;
+	}
+
+	// Send the new owner and ammo before going (back) to sleep. Flushes dormancy if we're dormant.
+	ForceNetUpdate();
+}
+
+void AGSWeapon::FlushAmmoNetDormancy()
+{
+	if (GetLocalRole() == ROLE_Authority && NetDormancy > DORM_Awake)
+	{
+		FlushNetDormancy();
+	}
+}
+
 void AGSWeapon::BeginPlay()
 {
 	ResetWeapon();
@@ -408,6 +503,7 @@ void AGSWeapon::BeginPlay()
 	{
 		// Spawned into the world without an owner, enable collision as we are in pickup mode
 		CollisionComp->SetCollisionEnabled(ECollisionEnabled::QueryOnly);
+		SetNetState(EGSWeaponNetState::Dropped);
 	}
 
 	Super::BeginPlay();
@@ -415,15 +511,7 @@ void AGSWeapon::BeginPlay()
 
 void AGSWeapon::EndPlay(EEndPlayReason::Type EndPlayReason)
 {
-	if (LineTraceTargetActor)
-	{
-		LineTraceTargetActor->Destroy();
-	}
-
-	if (SphereTraceTargetActor)
-	{
-		SphereTraceTargetActor->Destroy();
-	}
+	ReturnTargetActors();
 
 	Super::EndPlay(EndPlayReason);
 }
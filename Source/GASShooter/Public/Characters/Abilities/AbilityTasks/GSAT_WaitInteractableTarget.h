@@ -55,6 +55,15 @@ protected:
 
 	FTimerHandle TraceTimerHandle;
 
+	// View and TraceStart from the last time we actually traced. If we haven't moved or turned much since then, we
+	// reuse that result instead of tracing again.
+	FVector LastTraceViewLocation;
+	FVector LastTraceViewDirection;
+	FVector LastTraceStart;
+	float LastTraceTime;
+	uint32 LastTraceAvailabilityVersion;
+	bool bHasLastTrace;
+
 	virtual void OnDestroy(bool AbilityEnded) override;
 
 	/** Traces as normal, but will manually filter all hit actors */
@@ -64,8 +73,15 @@ protected:
 
 	bool ClipCameraRayToAbilityRange(FVector CameraLocation, FVector CameraDirection, FVector AbilityCenter, float AbilityRange, FVector& ClippedPosition) const;
 
+	void GetViewPoint(const FVector& TraceStart, FVector& OutViewLocation, FVector& OutViewDirection) const;
+
+	// True if the view and TraceStart are close enough to the last trace that its result is still good
+	bool CanReuseLastTrace(const FVector& ViewLocation, const FVector& ViewDirection, const FVector& TraceStart) const;
+
 	UFUNCTION()
 	void PerformTrace();
 
+	void ShowDebugTrace(const FVector& TraceStart, const FVector& TraceEnd, const FHitResult& HitResult) const;
+
 	FGameplayAbilityTargetDataHandle MakeTargetData(const FHitResult& HitResult) const;
 };
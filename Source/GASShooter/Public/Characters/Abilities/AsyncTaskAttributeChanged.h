@@ -36,6 +36,9 @@ public:
 	UFUNCTION(BlueprintCallable)
 	void EndTask();
 
+	// Stops broadcasting OnAttributeChanged but leaves the task alive for its owner's EndTask()
+	void StopListening();
+
 protected:
 	UPROPERTY()
 	UAbilitySystemComponent* ASC;
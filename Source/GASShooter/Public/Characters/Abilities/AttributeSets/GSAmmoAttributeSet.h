@@ -14,10 +14,26 @@
 	GAMEPLAYATTRIBUTE_VALUE_SETTER(PropertyName) \
 	GAMEPLAYATTRIBUTE_VALUE_INITTER(PropertyName)
 
+// The reserve ammo attributes for an ammo type
+USTRUCT()
+struct GASSHOOTER_API FGSAmmoTypeAttributes
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FGameplayTag AmmoTag;
+
+	UPROPERTY()
+	FGameplayAttribute ReserveAmmoAttribute;
+
+	UPROPERTY()
+	FGameplayAttribute MaxReserveAmmoAttribute;
+};
+
 /**
  * 
  */
-UCLASS()
+UCLASS(config = Game)
 class GASSHOOTER_API UGSAmmoAttributeSet : public UAttributeSet
 {
 	GENERATED_BODY()
@@ -53,8 +69,27 @@ public:
 	virtual void PostGameplayEffectExecute(const FGameplayEffectModCallbackData& Data) override;
 	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
 
-	static FGameplayAttribute GetReserveAmmoAttributeFromTag(FGameplayTag& PrimaryAmmoTag);
-	static FGameplayAttribute GetMaxReserveAmmoAttributeFromTag(FGameplayTag& PrimaryAmmoTag);
+	static FGameplayAttribute GetReserveAmmoAttributeFromTag(const FGameplayTag& PrimaryAmmoTag);
+	static FGameplayAttribute GetMaxReserveAmmoAttributeFromTag(const FGameplayTag& PrimaryAmmoTag);
+
+	// Returns the attributes registered for the ammo type or nullptr
+	static const FGSAmmoTypeAttributes* FindAmmoType(const FGameplayTag& AmmoTag);
+
+	// Returns the ammo type that ReserveAmmoAttribute belongs to or nullptr
+	static const FGSAmmoTypeAttributes* FindAmmoTypeByReserveAttribute(const FGameplayAttribute& ReserveAmmoAttribute);
+
+	// Every registered ammo type, built in ones first
+	static const TArray<FGSAmmoTypeAttributes>& GetAmmoTypes();
+
+	// Clamps the reserve ammo of a registered ammo type to [0, max]. Server only.
+	static void ClampReserveAmmo(UAbilitySystemComponent* AbilityComp, const FGSAmmoTypeAttributes& AmmoType);
+
+	// Rebuilds the ammo types from the current CDO and its config. Called by UGSEngineSubsystem after engine init and
+	// before every world is initialized, so PIE sessions and hot reloads pick up changes.
+	static void RebuildAmmoTypes();
+
+	virtual void PostInitProperties() override;
+	virtual void PostReloadConfig(FProperty* PropertyThatWasLoaded) override;
 
 protected:
 	// Cache tags
@@ -62,6 +97,26 @@ protected:
 	FGameplayTag RocketAmmoTag;
 	FGameplayTag ShotgunAmmoTag;
 
+	// Ammo types from DefaultGame.ini on top of Rifle, Rocket, and Shotgun. Their reserve ammo attributes can be on any
+	// AttributeSet. UGSGE_AmmoGrant grants them and UGSAbilitySystemComponent clamps them without any code changes.
+	UPROPERTY(config)
+	TArray<FGSAmmoTypeAttributes> AdditionalAmmoTypes;
+
+	// Every ammo type by tag and by reserve ammo attribute. Built from the CDO the first time it's used after being invalidated.
+	struct FAmmoTypeRegistry
+	{
+		TArray<FGSAmmoTypeAttributes> AmmoTypes;
+		TMap<FGameplayTag, int32> AmmoTypeIndexByTag;
+		TMap<FGameplayAttribute, int32> AmmoTypeIndexByReserveAttribute;
+		bool bBuilt = false;
+	};
+
+	static FAmmoTypeRegistry AmmoTypeRegistry;
+
+	static const FAmmoTypeRegistry& GetAmmoTypeRegistry();
+
+	void RegisterAmmoType(FAmmoTypeRegistry& Registry, const FGameplayTag& AmmoTag, const FGameplayAttribute& ReserveAmmoAttribute, const FGameplayAttribute& MaxReserveAmmoAttribute) const;
+
 	// Helper function to proportionally adjust the value of an attribute when it's associated max attribute changes.
 	// (i.e. When MaxHealth increases, Health increases by an amount that maintains the same percentage as before)
 	void AdjustAttributeForMaxChange(FGameplayAttributeData& AffectedAttribute, const FGameplayAttributeData& MaxAttribute, float NewMaxValue, const FGameplayAttribute& AffectedAttributeProperty);
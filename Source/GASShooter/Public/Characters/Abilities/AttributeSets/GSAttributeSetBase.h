@@ -138,6 +138,9 @@ protected:
 	// (i.e. When MaxHealth increases, Health increases by an amount that maintains the same percentage as before)
 	void AdjustAttributeForMaxChange(FGameplayAttributeData& AffectedAttribute, const FGameplayAttributeData& MaxAttribute, float NewMaxValue, const FGameplayAttribute& AffectedAttributeProperty);
 
+	// Counts received updates for GS.Attributes.ReplicationReport. Does nothing in Shipping.
+	void RecordReplicatedAttribute(const FGameplayAttribute& Attribute);
+
 	/**
 	* These OnRep functions exist to make sure that the ability system internal representations are synchronized properly during replication
 	**/
@@ -4,8 +4,10 @@
 
 #include "CoreMinimal.h"
 #include "AbilitySystemComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "GSAbilitySystemComponent.generated.h"
 
+class UGSAbilitySystemComponent;
 class USkeletalMeshComponent;
 
 /**
@@ -42,7 +44,7 @@ public:
 * Data about montages that is replicated to simulated clients.
 */
 USTRUCT()
-struct GASSHOOTER_API FGameplayAbilityRepAnimMontageForMesh
+struct GASSHOOTER_API FGameplayAbilityRepAnimMontageForMesh : public FFastArraySerializerItem
 {
 	GENERATED_BODY();
 
@@ -61,6 +63,43 @@ public:
 		: Mesh(InMesh), RepMontageInfo()
 	{
 	}
+
+	void PostReplicatedAdd(const struct FGameplayAbilityRepAnimMontageForMeshArray& InArraySerializer);
+	void PostReplicatedChange(const struct FGameplayAbilityRepAnimMontageForMeshArray& InArraySerializer);
+};
+
+/**
+* Delta serialized montage data for every mesh. Only the meshes whose montage changed are sent and processed on clients.
+*/
+USTRUCT()
+struct GASSHOOTER_API FGameplayAbilityRepAnimMontageForMeshArray : public FFastArraySerializer
+{
+	GENERATED_BODY();
+
+public:
+	UPROPERTY()
+	TArray<FGameplayAbilityRepAnimMontageForMesh> Items;
+
+	UPROPERTY(NotReplicated)
+	UGSAbilitySystemComponent* Owner;
+
+	FGameplayAbilityRepAnimMontageForMeshArray() : Owner(nullptr)
+	{
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FGameplayAbilityRepAnimMontageForMesh, FGameplayAbilityRepAnimMontageForMeshArray>(Items, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FGameplayAbilityRepAnimMontageForMeshArray> : public TStructOpsTypeTraitsBase2<FGameplayAbilityRepAnimMontageForMeshArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
 };
 
 /**
@@ -100,6 +139,9 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Abilities")
 	FGameplayAbilitySpecHandle FindAbilitySpecHandleForClass(TSubclassOf<UGameplayAbility> AbilityClass, UObject* OptionalSourceObject=nullptr);
 
+	// Rebuilds the InputID and ability class lookups on the next use. Call this if you change a Spec's InputID directly.
+	void MarkAbilitySpecIndexDirty();
+
 	// Turn on RPC batching in ASC. Off by default.
 	virtual bool ShouldDoServerAbilityRPCBatch() const override { return true; }
 
@@ -156,6 +198,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GameplayEffects", Meta = (DisplayName = "ApplyGameplayEffectToTargetWithPrediction"))
 	FActiveGameplayEffectHandle BP_ApplyGameplayEffectToTargetWithPrediction(TSubclassOf<UGameplayEffect> GameplayEffectClass, UAbilitySystemComponent* Target, float Level, FGameplayEffectContextHandle Context);
 
+	/**
+	* Returns an outgoing spec for an instant, SetByCaller driven GameplayEffect like UGSGE_AmmoGrant that is made once and reused.
+	* SetByCaller magnitudes keep their values from the last use so set every one of them before applying it.
+	*/
+	FGameplayEffectSpec* GetReusableOutgoingSpec(TSubclassOf<UGameplayEffect> GameplayEffectClass);
+
 
 	// ----------------------------------------------------------------------------------------------------------------
 	//	AnimMontage Support for multiple USkeletalMeshComponents on the AvatarActor.
@@ -214,6 +262,40 @@ public:
 	float GetCurrentMontageSectionTimeLeftForMesh(USkeletalMeshComponent* InMesh);
 
 protected:
+	// ----------------------------------------------------------------------------------------------------------------
+	//	Lookups into ActivatableAbilities so that input presses and class lookups don't scan every granted ability.
+	//	Kept up to date as abilities are given and removed, rebuilt when ActivatableAbilities replicates.
+	// ----------------------------------------------------------------------------------------------------------------
+
+	TMap<int32, TArray<FGameplayAbilitySpecHandle>> AbilitySpecHandlesByInputID;
+
+	// Keys are never dereferenced
+	TMap<UClass*, TArray<FGameplayAbilitySpecHandle>> AbilitySpecHandlesByClass;
+
+	// Index into ActivatableAbilities.Items. Can go stale when Items are removed, in which case it's rebuilt.
+	TMap<FGameplayAbilitySpecHandle, int32> AbilitySpecIndexByHandle;
+
+	bool bAbilitySpecIndexDirty;
+
+	// Specs made by GetReusableOutgoingSpec(). Keys are never dereferenced.
+	TMap<UClass*, FGameplayEffectSpecHandle> ReusableOutgoingSpecs;
+
+	bool bReserveAmmoClampsBound;
+
+	// Clamps ammo types from UGSAmmoAttributeSet's config whose reserve ammo lives on another AttributeSet
+	void BindReserveAmmoClamps();
+
+	void OnReserveAmmoChanged(const FOnAttributeChangeData& Data);
+
+	virtual void OnGiveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRemoveAbility(FGameplayAbilitySpec& AbilitySpec) override;
+	virtual void OnRep_ActivateAbilities() override;
+
+	void RebuildAbilitySpecIndex();
+
+	// Same as FindAbilitySpecFromHandle() without scanning ActivatableAbilities
+	FGameplayAbilitySpec* FindAbilitySpecFromHandleIndexed(FGameplayAbilitySpecHandle Handle);
+
 	// ----------------------------------------------------------------------------------------------------------------
 	//	AnimMontage Support for multiple USkeletalMeshComponents on the AvatarActor.
 	//  Only one ability can be animating at a time though?
@@ -230,8 +312,8 @@ protected:
 
 	// Data structure for replicating montage info to simulated clients
 	// Will be max one element per skeletal mesh on the AvatarActor
-	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedAnimMontageForMesh)
-	TArray<FGameplayAbilityRepAnimMontageForMesh> RepAnimMontageInfoForMeshes;
+	UPROPERTY(Replicated)
+	FGameplayAbilityRepAnimMontageForMeshArray RepAnimMontageInfoForMeshes;
 
 	// Finds the existing FGameplayAbilityLocalAnimMontageForMesh for the mesh or creates one if it doesn't exist
 	FGameplayAbilityLocalAnimMontageForMesh& GetLocalAnimMontageInfoForMesh(USkeletalMeshComponent* InMesh);
@@ -241,16 +323,19 @@ protected:
 	// Called when a prediction key that played a montage is rejected
 	void OnPredictiveMontageRejectedForMesh(USkeletalMeshComponent* InMesh, UAnimMontage* PredictiveMontage);
 
-	// Copy LocalAnimMontageInfo into RepAnimMontageInfo
+	// Copy LocalAnimMontageInfo into RepAnimMontageInfo. Marks it dirty for replication if anything changed.
 	void AnimMontage_UpdateReplicatedDataForMesh(USkeletalMeshComponent* InMesh);
 	void AnimMontage_UpdateReplicatedDataForMesh(FGameplayAbilityRepAnimMontageForMesh& OutRepAnimMontageInfo);
 
 	// Copy over playing flags for duplicate animation data
 	void AnimMontage_UpdateForcedPlayFlagsForMesh(FGameplayAbilityRepAnimMontageForMesh& OutRepAnimMontageInfo);	
 
-	UFUNCTION()
+	// Processes every mesh's replicated montage, used when we were not ready for one earlier
 	virtual void OnRep_ReplicatedAnimMontageForMesh();
 
+	// Called from the fast array when one mesh's montage data replicates
+	virtual void OnRep_ReplicatedAnimMontageForMesh(FGameplayAbilityRepAnimMontageForMesh& NewRepMontageInfoForMesh);
+
 	// Returns true if we are ready to handle replicated montage information
 	virtual bool IsReadyForReplicatedMontageForMesh();
 
@@ -271,4 +356,6 @@ protected:
 	void ServerCurrentMontageSetPlayRateForMesh(USkeletalMeshComponent* InMesh, UAnimMontage* ClientAnimMontage, float InPlayRate);
 	void ServerCurrentMontageSetPlayRateForMesh_Implementation(USkeletalMeshComponent* InMesh, UAnimMontage* ClientAnimMontage, float InPlayRate);
 	bool ServerCurrentMontageSetPlayRateForMesh_Validate(USkeletalMeshComponent* InMesh, UAnimMontage* ClientAnimMontage, float InPlayRate);
+
+	friend struct FGameplayAbilityRepAnimMontageForMesh;
 };
@@ -6,6 +6,9 @@
 #include "AbilitySystemGlobals.h"
 #include "GSAbilitySystemGlobals.generated.h"
 
+class UGSGE_AmmoGrant;
+class UGSGE_Bounty;
+
 /**
  * Child class of UAbilitySystemGlobals.
  * Do not try to get a reference to this or call into it during constructors of other UObjects. It will crash in packaged games.
@@ -37,6 +40,23 @@ public:
 	UPROPERTY()
 	FGameplayTag InteractingRemovalTag;
 
+	/**
+	* Prebuilt GameplayEffects that are applied with SetByCaller magnitudes so that we never have to make GameplayEffects at
+	* runtime. Apply them with UGSAbilitySystemComponent::GetReusableOutgoingSpec().
+	*/
+
+	UPROPERTY()
+	TSubclassOf<UGSGE_AmmoGrant> AmmoGrantEffect;
+
+	UPROPERTY()
+	TSubclassOf<UGSGE_Bounty> BountyEffect;
+
+	UPROPERTY()
+	FGameplayTag XPBountyTag;
+
+	UPROPERTY()
+	FGameplayTag GoldBountyTag;
+
 	static UGSAbilitySystemGlobals& GSGet()
 	{
 		return dynamic_cast<UGSAbilitySystemGlobals&>(Get());
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "GameplayEffectExecutionCalculation.h"
+#include "GameplayTagContainer.h"
 #include "GSDamageExecutionCalc.generated.h"
 
 /**
@@ -17,8 +18,35 @@ class GASSHOOTER_API UGSDamageExecutionCalc : public UGameplayEffectExecutionCal
 public:
 	UGSDamageExecutionCalc();
 
+	virtual void PostInitProperties() override;
+	virtual void PostLoad() override;
+
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 	virtual void Execute_Implementation(const FGameplayEffectCustomExecutionParameters& ExecutionParams, OUT FGameplayEffectCustomExecutionOutput& OutExecutionOutput) const override;
 
 protected:
-	float HeadShotMultiplier;
+	// Damage multiplier for hits on these bones. Bones that aren't listed do normal damage.
+	UPROPERTY(EditDefaultsOnly, Category = "Damage")
+	TMap<FName, float> HitZoneMultipliers;
+
+	// Hits on this bone only use their HitZoneMultiplier if the GameplayEffect can head shot and are tagged as head shots
+	UPROPERTY(EditDefaultsOnly, Category = "Damage")
+	FName HeadBoneName;
+
+	FGameplayTag DamageTag;
+	FGameplayTag CanHeadShotTag;
+	FGameplayTag HeadShotTag;
+
+	// HitZoneMultipliers flattened so that a lookup is a few FName compares
+	TArray<FName> HitZoneBoneNames;
+	TArray<float> HitZoneBoneMultipliers;
+	int32 HeadHitZoneIndex;
+
+	void BuildHitZoneLookup();
+
+	// Returns the index of the bone in HitZoneBoneNames or INDEX_NONE
+	int32 FindHitZone(const FName& BoneName) const;
 };
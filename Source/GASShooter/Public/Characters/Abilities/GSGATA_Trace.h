@@ -71,6 +71,11 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ExposeOnSpawn = true), Category = "Trace")
 	int32 NumberOfTraces;
 
+	// When doing more than one trace (shotguns), aim once from the player ViewPoint and generate every pellet's spread
+	// direction in a single pass instead of doing a camera trace per pellet. Ignored with PersistentHitResults.
+	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ExposeOnSpawn = true), Category = "Trace")
+	bool bBatchPelletTraces;
+
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ExposeOnSpawn = true), Category = "Trace")
 	bool bIgnoreBlockingHits;
 
@@ -81,6 +86,10 @@ public:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, meta = (ExposeOnSpawn = true), Category = "Trace")
 	bool bUsePersistentHitResults;
 
+	// Bytes the last trace allocated growing this TargetActor's scratch buffers. Should be 0 once warmed up.
+	UPROPERTY(BlueprintReadOnly, Category = "Trace")
+	int32 LastTraceBytesAllocated;
+
 	UFUNCTION(BlueprintCallable)
 	virtual void ResetSpread();
 
@@ -115,17 +124,46 @@ public:
 
 	virtual void AimWithPlayerController(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart, FVector& OutTraceEnd, bool bIgnorePitch = false);
 
+	// Batched version of AimWithPlayerController for multi-pellet weapons. Does one camera trace and one random stream
+	// for all pellets. Returns false if we can't aim (simulated proxies), OutTraceEnds will be empty in that case.
+	virtual bool AimPelletsWithPlayerController(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart, int32 NumPellets, TArray<FVector>& OutTraceEnds);
+
 	virtual bool ClipCameraRayToAbilityRange(FVector CameraLocation, FVector CameraDirection, FVector AbilityCenter, float AbilityRange, FVector& ClippedPosition);
 
 	virtual void StopTargeting();
 
+	// Called by UGSTargetActorPoolSubsystem when the TargetActor is returned. Clears everything the last lease changed
+	// that Configure() doesn't set, so the next lease starts from the class defaults.
+	virtual void ResetForReuse();
+
 protected:
 	// Trace End point, useful for debug drawing
 	FVector CurrentTraceEnd;
 	
+	// Reused across targeting sessions. Hidden when we stop targeting and only grown when we need more of them.
 	TArray<TWeakObjectPtr<AGameplayAbilityWorldReticle>> ReticleActors;
+
+	// What the current ReticleActors were spawned with. If these change, the ReticleActors are respawned.
+	UPROPERTY()
+	TSubclassOf<AGameplayAbilityWorldReticle> SpawnedReticleClass;
+	bool bSpawnedReticlesProduceTargetDataOnServer;
+
 	TArray<FHitResult> PersistentHitResults;
 
+	// Scratch buffers reused between traces. They keep their capacity so that steady state tracing doesn't allocate.
+	TArray<FHitResult> ScratchTraceHitResults;
+	TArray<FHitResult> ScratchAimHitResults;
+	TArray<FVector> ScratchPelletTraceEnds;
+
+	// Removes hits on actors that don't pass the filter without reallocating, and stamps TraceStart/TraceEnd
+	void FilterHitResults(TArray<FHitResult>& InOutHitResults, const FGameplayTargetDataFilterHandle& FilterHandle, const FVector& End) const;
+
+	SIZE_T GetScratchAllocatedSize() const;
+	void RecordScratchAllocations(SIZE_T ScratchBytesBeforeTrace);
+
+	// Traces from the player ViewPoint to find what we're aiming at. Shared by the single and batched aim paths.
+	virtual FVector GetAdjustedAimDirection(const AActor* InSourceActor, FCollisionQueryParams Params, const FVector& TraceStart);
+
 	virtual FGameplayAbilityTargetDataHandle MakeTargetData(const TArray<FHitResult>& HitResults) const;
 	virtual TArray<FHitResult> PerformTrace(AActor* InSourceActor);
 
@@ -133,5 +171,6 @@ protected:
 	virtual void ShowDebugTrace(TArray<FHitResult>& HitResults, EDrawDebugTrace::Type DrawDebugType, float Duration = 2.0f) PURE_VIRTUAL(AGSGATA_Trace, return;);
 
 	virtual AGameplayAbilityWorldReticle* SpawnReticleActor(FVector Location, FRotator Rotation);
+	virtual void HideReticleActors();
 	virtual void DestroyReticleActors();
 };
@@ -0,0 +1,27 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "GSGE_AmmoGrant.generated.h"
+
+/**
+ * Instant GameplayEffect that adds reserve ammo. Has a modifier for every ammo type in UGSAmmoAttributeSet::GetAmmoTypes(),
+ * added by RefreshAmmoModifiers() once the ammo types are known rather than in the constructor. The amount for each ammo type is SetByCaller using the ammo type's tag (Weapon.Ammo.Rifle, etc). Every ammo type's
+ * magnitude must be set, use 0 for types that aren't granted.
+ */
+UCLASS()
+class GASSHOOTER_API UGSGE_AmmoGrant : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UGSGE_AmmoGrant();
+
+	// Replaces the modifiers with one for every current ammo type. Called on the CDO by UGSEngineSubsystem.
+	void RefreshAmmoModifiers();
+
+protected:
+	void AddReserveAmmoModifier(const FGameplayAttribute& ReserveAmmoAttribute, const FGameplayTag& AmmoTypeTag);
+};
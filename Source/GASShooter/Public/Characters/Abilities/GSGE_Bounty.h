@@ -0,0 +1,20 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameplayEffect.h"
+#include "GSGE_Bounty.generated.h"
+
+/**
+ * Instant GameplayEffect that gives the killer XP and Gold. The amounts are SetByCaller with Data.Bounty.XP and
+ * Data.Bounty.Gold.
+ */
+UCLASS()
+class GASSHOOTER_API UGSGE_Bounty : public UGameplayEffect
+{
+	GENERATED_BODY()
+
+public:
+	UGSGE_Bounty();
+};
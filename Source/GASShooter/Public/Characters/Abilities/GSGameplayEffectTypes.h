@@ -47,8 +47,7 @@ public:
 			// Does a deep copy of the hit result
 			NewContext->AddHitResult(*GetHitResult(), true);
 		}
-		// Shallow copy of TargetData, is this okay?
-		NewContext->TargetData.Append(TargetData);
+		// TargetData was already shallow copied above. It's never modified after it's made so sharing it is fine.
 		return NewContext;
 	}
 
@@ -56,6 +55,17 @@ public:
 
 protected:
 	FGameplayAbilityTargetDataHandle TargetData;
+
+	// Packs single hit TargetData with quantized vectors and bone indices. Any other TargetData types are sent the
+	// normal way.
+	bool NetSerializeTargetData(FArchive& Ar, class UPackageMap* Map, bool& bOutSuccess);
+
+	static void NetSerializeHitResult(FArchive& Ar, FHitResult& HitResult);
+
+#if !UE_BUILD_SHIPPING
+	// Logs how many bytes this context takes with the default TargetData serialization and with ours
+	void MeasureNetSerialize(class UPackageMap* Map);
+#endif
 };
 
 template<>
@@ -0,0 +1,79 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GSInteractableSubsystem.generated.h"
+
+class ULevel;
+
+struct GASSHOOTER_API FGSInteractableEntry
+{
+	TWeakObjectPtr<AActor> Actor;
+
+	// Cached for static Actors. Movable Actors read their live location.
+	FVector Location;
+
+	float BoundsRadius;
+
+	FGSInteractableEntry() : Location(FVector::ZeroVector), BoundsRadius(0.0f)
+	{
+	}
+};
+
+/**
+ * Spatial index of every Actor that implements IGSInteractable. Lets interaction traces find out cheaply if there is
+ * anything to interact with nearby before doing any scene queries.
+ * Static Actors are bucketed in a uniform grid. Movable Actors (heroes) are few and are kept in a flat list.
+ */
+UCLASS()
+class GASSHOOTER_API UGSInteractableSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	UGSInteractableSubsystem();
+
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+	void RegisterInteractable(AActor* Actor);
+
+	// Returns true if any interactable Actor other than IgnoreActor has bounds within Range of Location
+	bool HasInteractableInRange(const FVector& Location, float Range, const AActor* IgnoreActor = nullptr);
+
+	// Call when an interactable's IsAvailableForInteraction() result may have changed so that cached interaction
+	// traces are redone
+	UFUNCTION(BlueprintCallable, Category = "GASShooter|Interaction")
+	void NotifyAvailabilityChanged(AActor* Actor);
+
+	// Changes every time NotifyAvailabilityChanged() is called
+	uint32 GetAvailabilityVersion() const
+	{
+		return AvailabilityVersion;
+	}
+
+protected:
+	// Size of a grid cell in cm
+	float CellSize;
+
+	bool bIndexBuilt;
+
+	uint32 AvailabilityVersion;
+
+	TMap<FIntVector, TArray<FGSInteractableEntry>> StaticCells;
+
+	TArray<FGSInteractableEntry> MovableInteractables;
+
+	FDelegateHandle ActorSpawnedDelegateHandle;
+	FDelegateHandle LevelAddedDelegateHandle;
+
+	FIntVector GetCell(const FVector& Location) const;
+
+	// Scans the world for interactables the first time we are queried
+	void BuildIndex();
+
+	void OnActorSpawned(AActor* Actor);
+	void OnLevelAddedToWorld(ULevel* Level, UWorld* World);
+};
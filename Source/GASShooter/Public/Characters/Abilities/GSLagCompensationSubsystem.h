@@ -0,0 +1,111 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Abilities/GameplayAbilityTargetTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "GSLagCompensationSubsystem.generated.h"
+
+class AGSCharacterBase;
+class APlayerState;
+
+/**
+* One recorded pose of a character's hitbox (its collision capsule).
+*/
+struct GASSHOOTER_API FGSHitboxSnapshot
+{
+	// Server world time when this pose was recorded
+	float Time;
+
+	FVector Location;
+
+	FQuat Rotation;
+
+	FGSHitboxSnapshot() : Time(0.0f), Location(FVector::ZeroVector), Rotation(FQuat::Identity)
+	{
+	}
+};
+
+/**
+* Fixed size ring buffer of hitbox poses for one character. Memory is allocated once on registration.
+*/
+struct GASSHOOTER_API FGSHitboxHistory
+{
+	TArray<FGSHitboxSnapshot> Snapshots;
+
+	// Index the next snapshot will be written to
+	int32 Head;
+
+	// Number of valid snapshots
+	int32 Num;
+
+	float CapsuleRadius;
+	float CapsuleHalfHeight;
+
+	FGSHitboxHistory() : Head(0), Num(0), CapsuleRadius(0.0f), CapsuleHalfHeight(0.0f)
+	{
+	}
+
+	void Init(int32 Capacity, float InCapsuleRadius, float InCapsuleHalfHeight);
+
+	void Record(float Time, const FVector& Location, const FQuat& Rotation);
+
+	// Returns the snapshot that is Index samples old. 0 is the newest.
+	const FGSHitboxSnapshot& GetFromNewest(int32 Index) const;
+};
+
+/**
+* Server-side lag compensation for client hits.
+* Keeps a short history of every character's hitbox and re-verifies client sent hit results against where the target
+* was on the shooter's screen when they fired. Verification is a point vs capsule test against the stored poses so it
+* never does a scene query.
+*/
+UCLASS()
+class GASSHOOTER_API UGSLagCompensationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UGSLagCompensationSubsystem();
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	// Start recording hitbox history for this character. Server only.
+	void RegisterCharacter(AGSCharacterBase* Character);
+
+	void UnregisterCharacter(AGSCharacterBase* Character);
+
+	// Returns the server time that the shooter was seeing when they fired, based on their ping
+	float GetRewindTimeForShooter(const APlayerState* ShooterPlayerState) const;
+
+	// Returns false if the hit is on a registered character and the impact point doesn't match its hitbox at RewindTime.
+	// Hits on anything else are always valid.
+	bool IsHitValid(const FHitResult& HitResult, float RewindTime) const;
+
+	/**
+	* Copies every TargetData entry that passes lag compensated verification into OutTargetData.
+	* Returns the number of rejected hits.
+	*/
+	int32 ValidateTargetData(const FGameplayAbilityTargetDataHandle& InTargetData, const APlayerState* ShooterPlayerState, FGameplayAbilityTargetDataHandle& OutTargetData) const;
+
+protected:
+	// How far back we keep history. Hits older than this are checked against the oldest pose.
+	float MaxRewindTime;
+
+	// How often we record a pose
+	float SampleInterval;
+
+	float TimeSinceLastSample;
+
+	TMap<TWeakObjectPtr<AGSCharacterBase>, FGSHitboxHistory> Histories;
+
+	void RecordSnapshots();
+};
@@ -0,0 +1,91 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GSTargetActorPoolSubsystem.generated.h"
+
+class AGSGATA_Trace;
+
+USTRUCT(BlueprintType)
+struct GASSHOOTER_API FGSTargetActorPoolStats
+{
+	GENERATED_BODY()
+
+	// Leases that reused a pooled TargetActor
+	UPROPERTY(BlueprintReadOnly, Category = "GASShooter|Targeting")
+	int32 Hits;
+
+	// Leases that had to spawn a new TargetActor
+	UPROPERTY(BlueprintReadOnly, Category = "GASShooter|Targeting")
+	int32 Misses;
+
+	// TargetActors currently leased out
+	UPROPERTY(BlueprintReadOnly, Category = "GASShooter|Targeting")
+	int32 NumLeased;
+
+	// Most TargetActors that were leased out at the same time
+	UPROPERTY(BlueprintReadOnly, Category = "GASShooter|Targeting")
+	int32 HighWaterMark;
+
+	FGSTargetActorPoolStats() : Hits(0), Misses(0), NumLeased(0), HighWaterMark(0)
+	{
+	}
+};
+
+USTRUCT()
+struct GASSHOOTER_API FGSTargetActorPoolBucket
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AGSGATA_Trace*> FreeTargetActors;
+
+	// Returned while an ability was still targeting with them. Moved to FreeTargetActors once that ability has ended.
+	UPROPERTY()
+	TArray<AGSGATA_Trace*> PendingTargetActors;
+
+	FGSTargetActorPoolStats Stats;
+};
+
+/**
+ * World pool of trace TargetActors. Weapons lease a TargetActor while equipped and return it when unequipped instead
+ * of each weapon spawning and destroying its own. Pooled by TargetActor class.
+ */
+UCLASS()
+class GASSHOOTER_API UGSTargetActorPoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	virtual void Deinitialize() override;
+
+	// Returns a TargetActor of the given class owned by NewOwner. Spawns one if the pool is empty.
+	AGSGATA_Trace* LeaseTargetActor(TSubclassOf<AGSGATA_Trace> TargetActorClass, AActor* NewOwner);
+
+	template<class T>
+	T* LeaseTargetActor(AActor* NewOwner)
+	{
+		return Cast<T>(LeaseTargetActor(T::StaticClass(), NewOwner));
+	}
+
+	// Stops the TargetActor from targeting and puts it back in the pool. If its ability is still active, e.g. a fire
+	// ability's WaitTargetData task outlived the weapon's equip, it is only reused after that ability ends.
+	void ReturnTargetActor(AGSGATA_Trace* TargetActor);
+
+	UFUNCTION(BlueprintCallable, Category = "GASShooter|Targeting")
+	FGSTargetActorPoolStats GetPoolStats(TSubclassOf<AGSGATA_Trace> TargetActorClass) const;
+
+	// Logs stats for every TargetActor class in the pool
+	void DumpPoolStats() const;
+
+protected:
+	UPROPERTY()
+	TMap<UClass*, FGSTargetActorPoolBucket> Buckets;
+
+	static bool IsTargetActorInUse(const AGSGATA_Trace* TargetActor);
+
+	// Frees the pending TargetActors whose ability has ended
+	void FreePendingTargetActors(FGSTargetActorPoolBucket& Bucket);
+};
@@ -17,11 +17,13 @@ struct GASSHOOTER_API FGSDamageNumber
 {
 	GENERATED_USTRUCT_BODY()
 
+	UPROPERTY()
 	float DamageAmount;
 
+	UPROPERTY()
 	FGameplayTagContainer Tags;
 
-	FGSDamageNumber() {}
+	FGSDamageNumber() : DamageAmount(0.0f) {}
 
 	FGSDamageNumber(float InDamageAmount, FGameplayTagContainer InTags) : DamageAmount(InDamageAmount)
 	{
@@ -66,6 +68,9 @@ public:
 
 	virtual void AddDamageNumber(float Damage, FGameplayTagContainer DamageNumberTags);
 
+	// Hides a finished damage number and keeps it around for the next one
+	virtual void ReleaseDamageNumber(class UGSDamageTextWidgetComponent* DamageText);
+
 
 	/**
 	* Getters for attributes from GSAttributeSetBase
@@ -112,6 +117,14 @@ protected:
 
 	TArray<FGSDamageNumber> DamageNumberQueue;
 	FTimerHandle DamageNumberTimer;
+
+	// Finished damage numbers waiting to be reused
+	UPROPERTY()
+	TArray<class UGSDamageTextWidgetComponent*> DamageNumberPool;
+
+	// Damage numbers beyond this that finish at the same time are destroyed instead of pooled
+	UPROPERTY(EditAnywhere, Category = "GASShooter|UI")
+	int32 MaxPooledDamageNumbers;
 	
 	// Reference to the ASC. It will live on the PlayerState or here if the character doesn't have a PlayerState.
 	UPROPERTY()
@@ -149,6 +162,8 @@ protected:
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	// Grant abilities on the Server. The Ability Specs will be replicated to the owning client.
 	virtual void AddCharacterAbilities();
 
@@ -161,6 +176,8 @@ protected:
 
 	virtual void ShowDamageNumber();
 
+	virtual class UGSDamageTextWidgetComponent* AcquireDamageNumber();
+
 
 	/**
 	* Setters for Attributes. Only use these in special cases like Respawning, otherwise use a GE to change Attributes.
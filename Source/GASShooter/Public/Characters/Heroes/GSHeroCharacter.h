@@ -6,6 +6,7 @@
 #include "Characters/GSCharacterBase.h"
 #include "Characters/Abilities/GSInteractable.h"
 #include "GameplayEffectTypes.h"
+#include "Net/Serialization/FastArraySerializer.h"
 #include "GSHeroCharacter.generated.h"
 
 class AGSWeapon;
@@ -25,12 +26,42 @@ enum class EGSHeroWeaponState : uint8
 };
 
 USTRUCT()
-struct GASSHOOTER_API FGSHeroInventory
+struct GASSHOOTER_API FGSHeroInventoryWeapon : public FFastArraySerializerItem
 {
-	GENERATED_USTRUCT_BODY()
+	GENERATED_BODY()
 
 	UPROPERTY()
-	TArray<AGSWeapon*> Weapons;
+	AGSWeapon* Weapon;
+
+	// What this slot last put in FGSHeroInventory::WeaponsByClass. Weapon may have changed or been garbage collected since.
+	TWeakObjectPtr<AGSWeapon> IndexedWeapon;
+
+	const UClass* IndexedClass;
+
+	FGSHeroInventoryWeapon() : Weapon(nullptr), IndexedClass(nullptr)
+	{
+	}
+
+	FGSHeroInventoryWeapon(AGSWeapon* InWeapon) : Weapon(InWeapon), IndexedClass(nullptr)
+	{
+	}
+
+	void PreReplicatedRemove(const struct FGSHeroInventory& InArraySerializer);
+	void PostReplicatedAdd(const struct FGSHeroInventory& InArraySerializer);
+	void PostReplicatedChange(const struct FGSHeroInventory& InArraySerializer);
+};
+
+/**
+* Delta serialized so that picking up or dropping a weapon only sends that slot. Keeps a weapon class to weapon index
+* in sync on the Server and on clients for cheap duplicate checks when overlapping pickups.
+*/
+USTRUCT()
+struct GASSHOOTER_API FGSHeroInventory : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FGSHeroInventoryWeapon> Weapons;
 
 	// Consumable items
 
@@ -39,6 +70,49 @@ struct GASSHOOTER_API FGSHeroInventory
 	// Door keys
 
 	// Etc
+
+	int32 Num() const
+	{
+		return Weapons.Num();
+	}
+
+	AGSWeapon* GetWeapon(int32 Index) const
+	{
+		return Weapons.IsValidIndex(Index) ? Weapons[Index].Weapon : nullptr;
+	}
+
+	int32 IndexOfWeapon(const AGSWeapon* InWeapon) const;
+
+	// Returns true if we hold a weapon of the exact same class
+	bool ContainsWeaponClass(const UClass* WeaponClass) const;
+
+	// Server only
+	void AddWeapon(AGSWeapon* InWeapon);
+	bool RemoveWeapon(AGSWeapon* InWeapon);
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FGSHeroInventoryWeapon, FGSHeroInventory>(Weapons, DeltaParms, *this);
+	}
+
+protected:
+	friend struct FGSHeroInventoryWeapon;
+
+	// Weak since on clients a Weapon can be destroyed and garbage collected before its slot is removed
+	TMap<const UClass*, TWeakObjectPtr<AGSWeapon>> WeaponsByClass;
+
+	// Replaces whatever the slot indexed before with its current Weapon
+	void IndexWeapon(FGSHeroInventoryWeapon& Entry);
+	void UnIndexWeapon(FGSHeroInventoryWeapon& Entry);
+};
+
+template<>
+struct TStructOpsTypeTraits<FGSHeroInventory> : public TStructOpsTypeTraitsBase2<FGSHeroInventory>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
 };
 
 /**
@@ -65,6 +139,7 @@ public:
 	// Only called on the Server. Calls before Server's AcknowledgePossession.
 	virtual void PossessedBy(AController* NewController) override;
 
+	// Returns nullptr while the floating status bar is culled
 	class UGSFloatingStatusBarWidget* GetFloatingStatusBar();
 
 	// Server handles knockdown - cancel abilities, remove effects, activate knockdown ability
@@ -247,9 +322,6 @@ protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GASShooter|UI")
 	TSubclassOf<class UGSFloatingStatusBarWidget> UIFloatingStatusBarClass;
 
-	UPROPERTY()
-	class UGSFloatingStatusBarWidget* UIFloatingStatusBar;
-
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "GASShooter|UI")
 	class UWidgetComponent* UIFloatingStatusBarComponent;
 
@@ -290,6 +362,8 @@ protected:
 
 	// Tag changed delegate handles
 	FDelegateHandle WeaponChangingDelayReplicationTagChangedDelegateHandle;
+	FDelegateHandle KnockedDownTagChangedDelegateHandle;
+	FDelegateHandle InteractingTagChangedDelegateHandle;
 
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
@@ -364,6 +438,10 @@ protected:
 	// Tag changed callbacks
 	virtual void WeaponChangingDelayReplicationTagChanged(const FGameplayTag CallbackTag, int32 NewCount);
 
+	// KnockedDownTag and InteractingTag decide if we can be revived. Tell UGSInteractableSubsystem when they change.
+	void BindInteractionAvailabilityTags();
+	virtual void InteractionAvailabilityTagChanged(const FGameplayTag CallbackTag, int32 NewCount);
+
 	UFUNCTION()
 	void OnRep_CurrentWeapon(AGSWeapon* LastWeapon);
 
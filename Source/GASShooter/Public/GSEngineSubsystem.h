@@ -3,6 +3,7 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "Engine/World.h"
 #include "Subsystems/EngineSubsystem.h"
 #include "GSEngineSubsystem.generated.h"
 
@@ -16,4 +17,13 @@ class GASSHOOTER_API UGSEngineSubsystem : public UEngineSubsystem
 	
 public:
 	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+	virtual void Deinitialize() override;
+
+protected:
+	FDelegateHandle PreWorldInitializationDelegateHandle;
+
+	// Ammo types come from config, so they are built here instead of from a CDO constructor
+	void RebuildAmmoTypes();
+
+	void OnPreWorldInitialization(UWorld* World, const UWorld::InitializationValues IVS);
 };
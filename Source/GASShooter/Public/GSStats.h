@@ -0,0 +1,109 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ProfilingDebugging/CsvProfiler.h"
+#include "Stats/Stats.h"
+
+/**
+* Stats for the gameplay systems. Shows up under "stat GASShooter" and in the GASShooter category of CSV profiles
+* (csvprofile start / -csvCaptureFrames) so that server frame time can be attributed to a system.
+* Cycle stats give the time and call count of a scope. Allocation counters are per frame, with running totals in
+* FGSAllocationCounter.
+* Everything here compiles out in Shipping.
+*/
+DECLARE_STATS_GROUP(TEXT("GASShooter"), STATGROUP_GASShooter, STATCAT_Advanced);
+
+CSV_DECLARE_CATEGORY_MODULE_EXTERN(GASSHOOTER_API, GASShooter);
+
+// Trace target actors
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Trace PerformTrace"), STAT_GSTracePerformTrace, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Trace ConfirmTargeting"), STAT_GSTraceConfirmTargeting, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Trace Tick"), STAT_GSTraceTick, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Trace Scratch Bytes Allocated"), STAT_GSTraceScratchBytesAllocated, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Trace Target Actors Spawned"), STAT_GSTraceTargetActorsSpawned, STATGROUP_GASShooter, GASSHOOTER_API);
+
+// Ability activation
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ASC AbilityLocalInputPressed"), STAT_GSAbilityLocalInputPressed, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("ASC BatchRPCTryActivateAbility"), STAT_GSBatchRPCTryActivateAbility, STATGROUP_GASShooter, GASSHOOTER_API);
+
+// Damage and attributes
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Damage Execution"), STAT_GSDamageExecution, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Attribute PostGameplayEffectExecute"), STAT_GSAttributePostExecute, STATGROUP_GASShooter, GASSHOOTER_API);
+
+// Inventory
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Inventory AddWeapon"), STAT_GSInventoryAddWeapon, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Inventory RemoveWeapon"), STAT_GSInventoryRemoveWeapon, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Inventory EquipWeapon"), STAT_GSInventoryEquipWeapon, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Inventory SpawnDefaultInventory"), STAT_GSInventorySpawnDefault, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Inventory Weapons Spawned"), STAT_GSInventoryWeaponsSpawned, STATGROUP_GASShooter, GASSHOOTER_API);
+
+// Montage replication
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Montage PlayMontageForMesh"), STAT_GSMontagePlayForMesh, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Montage UpdateReplicatedData"), STAT_GSMontageUpdateReplicatedData, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Montage OnRep"), STAT_GSMontageOnRep, STATGROUP_GASShooter, GASSHOOTER_API);
+
+// Projectiles
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Integrate"), STAT_GSProjectileIntegrate, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Projectile Sweep"), STAT_GSProjectileSweep, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("Projectile Visuals Spawned"), STAT_GSProjectileVisualsSpawned, STATGROUP_GASShooter, GASSHOOTER_API);
+
+// Pickups
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Pickup Respawn Batch"), STAT_GSPickupRespawnBatch, STATGROUP_GASShooter, GASSHOOTER_API);
+
+// Spawning
+DECLARE_CYCLE_STAT_EXTERN(TEXT("Spawn Scoring"), STAT_GSSpawnScoring, STATGROUP_GASShooter, GASSHOOTER_API);
+
+// HUD
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD UpdateStatusBars"), STAT_GSHUDUpdateStatusBars, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD FlushDamageNumbers"), STAT_GSHUDFlushDamageNumbers, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_CYCLE_STAT_EXTERN(TEXT("HUD ShowDamageNumbers"), STAT_GSHUDShowDamageNumbers, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("HUD Status Bar Widgets Created"), STAT_GSHUDStatusBarWidgetsCreated, STATGROUP_GASShooter, GASSHOOTER_API);
+DECLARE_DWORD_COUNTER_STAT_EXTERN(TEXT("HUD Damage Number Widgets Created"), STAT_GSHUDDamageNumberWidgetsCreated, STATGROUP_GASShooter, GASSHOOTER_API);
+
+#if !UE_BUILD_SHIPPING
+
+// Times the enclosing scope and counts its calls
+#define GS_SCOPE_CYCLE_COUNTER(Stat) \
+	SCOPE_CYCLE_COUNTER(Stat); \
+	CSV_SCOPED_TIMING_STAT(GASShooter, Stat)
+
+/**
+* Running total of what a GS_COUNT_ALLOCATIONS call site counted since startup. Unlike the stats these are never reset,
+* so tools like GS.Benchmark.Run can diff them around a piece of work. Game thread only.
+*/
+struct GASSHOOTER_API FGSAllocationCounter
+{
+	FGSAllocationCounter(const TCHAR* InStatName);
+
+	void Add(int64 Amount)
+	{
+		Total += Amount;
+	}
+
+	// Totals of every call site so far, summed by stat name
+	static void GetTotals(TMap<FName, int64>& OutTotals);
+
+private:
+	FName StatName;
+	int64 Total;
+	FGSAllocationCounter* Next;
+};
+
+// Adds Amount to a per frame allocation counter and to the call site's running total
+#define GS_COUNT_ALLOCATIONS(Stat, Amount) \
+	do \
+	{ \
+		INC_DWORD_STAT_BY(Stat, Amount); \
+		CSV_CUSTOM_STAT(GASShooter, Stat, static_cast<int32>(Amount), ECsvCustomStatOp::Accumulate); \
+		static FGSAllocationCounter Stat##Total(TEXT(#Stat)); \
+		Stat##Total.Add(Amount); \
+	} while (0)
+
+#else
+
+#define GS_SCOPE_CYCLE_COUNTER(Stat)
+#define GS_COUNT_ALLOCATIONS(Stat, Amount)
+
+#endif
@@ -29,6 +29,10 @@ public:
 	bool K2_CanBePickedUp(AGSCharacterBase* TestCharacter) const;
 	virtual bool K2_CanBePickedUp_Implementation(AGSCharacterBase* TestCharacter) const;
 
+	// Level placed pickups that respawn don't replicate themselves. Their active state is replicated for them by the
+	// GameState's UGSPickupStateComponent.
+	bool UsesSharedPickupState() const;
+
 protected:
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "GSPickup")
 	class UCapsuleComponent* CollisionComp;
@@ -59,7 +63,14 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Replicated)
 	AGSCharacterBase* PickedUpBy;
 
-	FTimerHandle TimerHandle_RespawnPickup;
+	// Bit in UGSPickupStateComponent. INDEX_NONE if we replicate ourselves.
+	int32 PickupStateIndex;
+
+	friend class UGSPickupStateComponent;
+	friend class UGSPickupSubsystem;
+
+	// Server only
+	void SetIsActive(bool bNewIsActive);
 
 	void PickupOnTouch(AGSCharacterBase* Pawn);
 
@@ -72,6 +83,7 @@ protected:
 	UFUNCTION(BlueprintImplementableEvent, Meta = (DisplayName = "OnPickedUp"))
 	void K2_OnPickedUp();
 
+	// Called by UGSPickupSubsystem, which then gives it to anyone already standing on it
 	virtual void RespawnPickup();
 
 	// Show effects when pickup appears
@@ -0,0 +1,105 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Components/ActorComponent.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "GSPickupStateComponent.generated.h"
+
+class AGSPickup;
+
+/**
+* 32 pickups worth of active flags
+*/
+USTRUCT()
+struct GASSHOOTER_API FGSPickupStateWord : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	// Clients don't get items in the Server's order, so every word says where it belongs
+	UPROPERTY()
+	uint16 WordIndex;
+
+	UPROPERTY()
+	uint32 Bits;
+
+	FGSPickupStateWord() : WordIndex(0), Bits(0)
+	{
+	}
+
+	void PostReplicatedAdd(const struct FGSPickupStateBits& InArraySerializer);
+	void PostReplicatedChange(const struct FGSPickupStateBits& InArraySerializer);
+};
+
+/**
+* Delta serialized so that a pickup changing state only sends its word
+*/
+USTRUCT()
+struct GASSHOOTER_API FGSPickupStateBits : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FGSPickupStateWord> Words;
+
+	UPROPERTY(NotReplicated)
+	class UGSPickupStateComponent* Owner;
+
+	FGSPickupStateBits() : Owner(nullptr)
+	{
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FGSPickupStateWord, FGSPickupStateBits>(Words, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FGSPickupStateBits> : public TStructOpsTypeTraitsBase2<FGSPickupStateBits>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+* Pickup manager on the GameState. Replicates whether every level placed, respawning pickup is active as one packed
+* bit array so that those pickups don't need to replicate at all. Pickups are indexed by name, which is the same on
+* the Server and on clients for Actors loaded with the persistent level.
+*/
+UCLASS()
+class GASSHOOTER_API UGSPickupStateComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	UGSPickupStateComponent();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	virtual void BeginPlay() override;
+
+	// Server only
+	void SetPickupActive(int32 PickupIndex, bool bActive);
+
+protected:
+	friend struct FGSPickupStateWord;
+
+	UPROPERTY(Replicated)
+	FGSPickupStateBits PickupBits;
+
+	// Indexed by bit
+	UPROPERTY()
+	TArray<AGSPickup*> Pickups;
+
+	bool bIndexBuilt;
+
+	// Collects and sorts the pickups. On the Server this also stops them from replicating themselves.
+	void BuildIndex();
+
+	// Client only. Applies the word to the pickups whose flag changed.
+	void OnWordReplicated(const FGSPickupStateWord& Word);
+};
@@ -0,0 +1,106 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "GSPickupSubsystem.generated.h"
+
+class AGSCharacterBase;
+class AGSPickup;
+
+/**
+* Two level hierarchical timing wheel of pickups. Scheduling and advancing are O(1) per pickup no matter how many are
+* waiting. The inner wheel has one slot per tick, the outer wheel one slot per inner revolution. Anything further out
+* waits in an overflow list that is re-sorted once per outer revolution.
+*/
+struct GASSHOOTER_API FGSPickupTimingWheel
+{
+	static const int32 NumSlots = 64;
+
+	struct FEntry
+	{
+		TWeakObjectPtr<AGSPickup> Pickup;
+		uint64 DueTick;
+	};
+
+	// Seconds per tick
+	float TickInterval;
+
+	FGSPickupTimingWheel();
+
+	void Schedule(AGSPickup* Pickup, float Delay);
+
+	// Advances time and appends every pickup that came due to OutDuePickups
+	void Advance(float DeltaTime, TArray<TWeakObjectPtr<AGSPickup>>& OutDuePickups);
+
+	void Empty();
+
+	int32 Num() const
+	{
+		return NumEntries;
+	}
+
+protected:
+	TArray<FEntry> InnerSlots[NumSlots];
+	TArray<FEntry> OuterSlots[NumSlots];
+	TArray<FEntry> Overflow;
+
+	uint64 CurrentTick;
+	float TimeSinceLastTick;
+	int32 NumEntries;
+
+	void Insert(const FEntry& Entry);
+
+	// Moves the entries of a slot or list back in through Insert() so that they land where they belong now
+	void Reinsert(TArray<FEntry>& Entries);
+};
+
+/**
+* Owns the respawn timers of every AGSPickup on the Server. Respawns that come due in the same frame are handled in one
+* pass that checks for characters standing on the pickups against a spatial hash of character positions instead of
+* each pickup running its own overlap query.
+*/
+UCLASS()
+class GASSHOOTER_API UGSPickupSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UGSPickupSubsystem();
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	// Server only. Respawns Pickup after Delay seconds.
+	void ScheduleRespawn(AGSPickup* Pickup, float Delay);
+
+	int32 GetNumScheduledRespawns() const;
+
+protected:
+	FGSPickupTimingWheel RespawnWheel;
+
+	// Pickups that came due this frame. Kept around to reuse the allocation.
+	TArray<TWeakObjectPtr<AGSPickup>> DueRespawns;
+
+	// Size of a pawn hash cell in cm. Should be larger than a pickup plus a character.
+	float PawnCellSize;
+
+	// Only valid while processing respawns
+	TMap<FIntPoint, TArray<AGSCharacterBase*>> PawnCells;
+
+	void ProcessDueRespawns();
+
+	void BuildPawnHash();
+
+	FIntPoint GetPawnCell(const FVector& Location) const;
+
+	// Gives the pickup to the first character whose capsule overlaps it
+	void GivePickupToOverlappingCharacter(AGSPickup* Pickup);
+};
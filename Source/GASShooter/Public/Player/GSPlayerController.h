@@ -49,10 +49,14 @@ public:
 	void SetHUDReticle(TSubclassOf<class UGSHUDReticle> ReticleClass);
 
 
-	UFUNCTION(Client, Reliable, WithValidation)
+	// Queues a damage number to show on this client. Everything queued in a frame is sent in one RPC per target. Server only.
 	void ShowDamageNumber(float DamageAmount, AGSCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags);
-	void ShowDamageNumber_Implementation(float DamageAmount, AGSCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags);
-	bool ShowDamageNumber_Validate(float DamageAmount, AGSCharacterBase* TargetCharacter, FGameplayTagContainer DamageNumberTags);
+
+	// Unreliable since a lost damage number doesn't matter and they would otherwise queue up behind each other
+	UFUNCTION(Client, Unreliable, WithValidation)
+	void ClientShowDamageNumbers(AGSCharacterBase* TargetCharacter, const TArray<FGSDamageNumber>& DamageNumbers);
+	void ClientShowDamageNumbers_Implementation(AGSCharacterBase* TargetCharacter, const TArray<FGSDamageNumber>& DamageNumbers);
+	bool ClientShowDamageNumbers_Validate(AGSCharacterBase* TargetCharacter, const TArray<FGSDamageNumber>& DamageNumbers);
 
 	// Simple way to RPC to the client the countdown until they respawn from the GameMode. Will be latency amount of out sync with the Server.
 	UFUNCTION(Client, Reliable, WithValidation)
@@ -69,6 +73,11 @@ protected:
 	UPROPERTY(BlueprintReadWrite, EditAnywhere, Category = "GASShooter|UI")
 	TSubclassOf<class UGSHUDWidget> UIHUDWidgetClass;
 
+	// Damage numbers queued this frame, sent in FlushDamageNumbers()
+	TMap<TWeakObjectPtr<AGSCharacterBase>, TArray<FGSDamageNumber>> PendingDamageNumbers;
+
+	void FlushDamageNumbers();
+
 	UPROPERTY(BlueprintReadWrite, Category = "GASShooter|UI")
 	class UGSHUDWidget* UIHUDWidget;
 
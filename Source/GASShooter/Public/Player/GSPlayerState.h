@@ -114,6 +114,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GASShooter|GSPlayerState|Attributes")
 	int32 GetPrimaryReserveAmmo() const;
 
+	// Switches to the active NetUpdateFrequency and replicates on the next net tick. Call when the client is waiting on
+	// us, for example when a prediction key needs to be acknowledged. Server only.
+	UFUNCTION(BlueprintCallable, Category = "GASShooter|GSPlayerState|Replication")
+	void FlushReplication();
+
 protected:
 	FGameplayTag DeadTag;
 	FGameplayTag KnockedDownTag;
@@ -127,12 +132,44 @@ protected:
 	UPROPERTY()
 	class UGSAmmoAttributeSet* AmmoAttributeSet;
 
+	// NetUpdateFrequency while the ASC has active abilities or anything on it changed within IdleDelay
+	UPROPERTY(EditDefaultsOnly, Category = "GASShooter|GSPlayerState|Replication")
+	float ActiveNetUpdateFrequency;
+
+	// NetUpdateFrequency when nothing is going on. PlayerStates are always relevant so this is paid per connection.
+	UPROPERTY(EditDefaultsOnly, Category = "GASShooter|GSPlayerState|Replication")
+	float IdleNetUpdateFrequency;
+
+	// Seconds without any ASC activity before dropping to IdleNetUpdateFrequency
+	UPROPERTY(EditDefaultsOnly, Category = "GASShooter|GSPlayerState|Replication")
+	float IdleDelay;
+
+	// How often we check if we can go idle
+	UPROPERTY(EditDefaultsOnly, Category = "GASShooter|GSPlayerState|Replication")
+	float NetUpdateFrequencyEvaluationInterval;
+
+	bool bNetUpdateFrequencyIdle;
+
+	float LastReplicationActivityTime;
+
+	FTimerHandle NetUpdateFrequencyEvaluationTimerHandle;
+
 	// Attribute changed delegate handles
 	FDelegateHandle HealthChangedDelegateHandle;
 
 	// Called when the game starts or when spawned
 	virtual void BeginPlay() override;
 
+	// Binds to everything on the ASC that will need to be replicated. Server only.
+	void BindReplicationActivityCallbacks();
+
+	// Something on the ASC changed, switch to the active rate if we were idle
+	void NoteReplicationActivity();
+
+	void EvaluateNetUpdateFrequency();
+
+	bool HasActiveAbilities() const;
+
 	// Attribute changed callbacks
 	virtual void HealthChanged(const FOnAttributeChangeData& Data);
 
@@ -15,6 +15,23 @@ class GASSHOOTER_API UGSDamageTextWidgetComponent : public UWidgetComponent
 	GENERATED_BODY()
 	
 public:
+	UGSDamageTextWidgetComponent();
+
+	// Set by the owning Character when this was created for its damage number pool
+	bool bReturnToPoolOnDestroy;
+
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
 	void SetDamageText(float Damage, const FGameplayTagContainer& Tags);
+
+	// The Blueprint destroys the component when its animation finishes. Pooled components go back to their Character
+	// instead so that the next damage number doesn't have to create and register a new component.
+	virtual void DestroyComponent(bool bPromoteChildren = false) override;
+
+	// Hides the component and takes its widget off the screen layer. Screen space widgets are otherwise only removed by
+	// TickComponent, which doesn't run while the component is pooled.
+	virtual void ReleaseToPool();
+
+	// Puts the component back to how its class defaults spawned it and stops any animation still playing on the widget
+	// so that SetDamageText starts from a clean widget
+	virtual void ResetForReuse();
 };
@@ -0,0 +1,93 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "GSFloatingStatusBarSubsystem.generated.h"
+
+class AGSCharacterBase;
+class UGSFloatingStatusBarWidget;
+class UWidgetComponent;
+
+USTRUCT()
+struct GASSHOOTER_API FGSFloatingStatusBarEntry
+{
+	GENERATED_BODY()
+
+	TWeakObjectPtr<AGSCharacterBase> Character;
+
+	TWeakObjectPtr<UWidgetComponent> WidgetComponent;
+
+	UPROPERTY()
+	TSubclassOf<UGSFloatingStatusBarWidget> WidgetClass;
+
+	// Only set while the Character is on screen and in range
+	UPROPERTY()
+	UGSFloatingStatusBarWidget* Widget;
+
+	FText CharacterName;
+
+	// Last values pushed to the Widget
+	float HealthPercentage;
+	float ManaPercentage;
+	float ShieldPercentage;
+
+	// The WidgetComponent is already hidden and not ticking
+	bool bHidden;
+
+	FGSFloatingStatusBarEntry() : Widget(nullptr), HealthPercentage(-1.0f), ManaPercentage(-1.0f), ShieldPercentage(-1.0f), bHidden(false)
+	{
+	}
+};
+
+/**
+* Owns every floating status bar on this client. Characters register their WidgetComponent and the subsystem lends it a
+* widget from a pool only while the Character is within range and in front of the camera. Bars are updated at a fixed
+* rate and only when a value moved enough to be visible, instead of on every attribute change.
+*/
+UCLASS()
+class GASSHOOTER_API UGSFloatingStatusBarSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UGSFloatingStatusBarSubsystem();
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	void RegisterStatusBar(AGSCharacterBase* Character, UWidgetComponent* WidgetComponent, TSubclassOf<UGSFloatingStatusBarWidget> WidgetClass, const FText& CharacterName);
+
+	void UnregisterStatusBar(AGSCharacterBase* Character);
+
+	bool IsStatusBarRegistered(const AGSCharacterBase* Character) const;
+
+	// Returns nullptr if the Character's status bar is currently culled
+	UGSFloatingStatusBarWidget* GetStatusBarWidget(const AGSCharacterBase* Character) const;
+
+protected:
+	float TimeSinceLastUpdate;
+
+	UPROPERTY()
+	TArray<FGSFloatingStatusBarEntry> Entries;
+
+	UPROPERTY()
+	TArray<UGSFloatingStatusBarWidget*> FreeWidgets;
+
+	void UpdateStatusBars();
+
+	// Pushes the Character's attributes to its Widget. Skips values that haven't changed by a visible amount unless bForce.
+	void UpdateStatusBarValues(FGSFloatingStatusBarEntry& Entry, bool bForce);
+
+	UGSFloatingStatusBarWidget* AcquireWidget(TSubclassOf<UGSFloatingStatusBarWidget> WidgetClass);
+
+	void ShowStatusBar(FGSFloatingStatusBarEntry& Entry);
+	void HideStatusBar(FGSFloatingStatusBarEntry& Entry);
+};
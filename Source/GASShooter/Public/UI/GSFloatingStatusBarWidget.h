@@ -7,7 +7,7 @@
 #include "GSFloatingStatusBarWidget.generated.h"
 
 /**
- * 
+ * Driven by UGSFloatingStatusBarSubsystem, which pushes throttled attribute values through the Set*Percentage events.
  */
 UCLASS()
 class GASSHOOTER_API UGSFloatingStatusBarWidget : public UUserWidget
@@ -29,4 +29,7 @@ public:
 
 	UFUNCTION(BlueprintImplementableEvent, BlueprintCallable)
 	void SetCharacterName(const FText& NewName);
+
+protected:
+	virtual void NativeConstruct() override;
 };
@@ -4,8 +4,14 @@
 
 #include "CoreMinimal.h"
 #include "GameFramework/Actor.h"
+#include "Characters/Abilities/GSAbilityTypes.h"
 #include "GSProjectile.generated.h"
 
+/**
+* Projectile Actor. Can either be spawned directly and moved by its ProjectileMovementComponent, or launched through
+* UGSProjectileSubsystem which simulates it in bulk and only uses pooled instances of this Actor as visuals and to run
+* the impact logic.
+*/
 UCLASS()
 class GASSHOOTER_API AGSProjectile : public AActor
 {
@@ -15,7 +21,63 @@ public:
 	// Sets default values for this actor's properties
 	AGSProjectile();
 
+	// Radius of the sweep when simulated by UGSProjectileSubsystem
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "PBProjectile")
+	float CollisionRadius;
+
+	// Seconds before a projectile simulated by UGSProjectileSubsystem expires without hitting anything
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "PBProjectile")
+	float MaxLifeSpan;
+
+	// Same on the Server and every client for a projectile launched through UGSProjectileSubsystem
+	UPROPERTY(BlueprintReadOnly, Category = "PBProjectile")
+	int32 RandomSeed;
+
+	// Radius around the impact in which Pawns are hit. 0 only hits the Actor that the projectile ran into.
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "PBProjectile")
+	float ImpactRadius;
+
+	// Directly spawned instances, e.g. from a Spawn Actor node in a fire ability, hand themselves over to
+	// UGSProjectileSubsystem on the Server and destroy themselves
+	UPROPERTY(EditDefaultsOnly, BlueprintReadOnly, Category = "PBProjectile")
+	bool bLaunchThroughSubsystem;
+
+	// Effects for the impact logic to apply to the hit targets. Set by UGSProjectileSubsystem before OnProjectileImpact().
+	UPROPERTY(BlueprintReadWrite, Category = "PBProjectile", Meta = (ExposeOnSpawn = true))
+	FGSGameplayEffectContainerSpec EffectContainerSpec;
+
+	// Called by UGSProjectileSubsystem when the simulated projectile hits something. Runs on clients too for their
+	// predicted and reconciled impacts, so check ShouldApplyImpactEffects() before applying gameplay effects.
+	// The native implementation applies EffectContainerSpec to the hit Actor or to the Pawns within ImpactRadius.
+	UFUNCTION(BlueprintNativeEvent, Category = "PBProjectile")
+	void OnProjectileImpact(const FHitResult& Hit);
+	virtual void OnProjectileImpact_Implementation(const FHitResult& Hit);
+
+	// Pooled instances are local Actors and always have authority, so this checks the net mode instead
+	UFUNCTION(BlueprintPure, Category = "PBProjectile")
+	bool ShouldApplyImpactEffects() const;
+
+	float GetInitialSpeed() const;
+
+	float GetGravityScale() const;
+
+	// Called between deferred spawn and FinishSpawning() for instances owned by UGSProjectileSubsystem.
+	// They never move themselves and are local only unless bReplicated.
+	void InitializeForSimulation(bool bReplicated);
+
+	// Shows or hides a pooled instance
+	void SetPooledActive(bool bActive);
+
 protected:
 	UPROPERTY(BlueprintReadOnly, VisibleAnywhere, Category = "PBProjectile")
 	class UProjectileMovementComponent* ProjectileMovement;
+
+	// True for instances owned by UGSProjectileSubsystem
+	bool bSimulatedBySubsystem;
+
+	virtual void BeginPlay() override;
+
+	// EffectContainerSpec, or a container spec that a Blueprint subclass declares itself and sets on spawn
+	// (BP_RocketLauncherProjectile's DamageEffectContainerSpec). Null if none has effects.
+	const FGSGameplayEffectContainerSpec* FindSpawnEffectContainerSpec() const;
 };
@@ -0,0 +1,146 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GameFramework/Actor.h"
+#include "Engine/NetSerialization.h"
+#include "Net/Serialization/FastArraySerializer.h"
+#include "GSProjectileReplicator.generated.h"
+
+class AGSProjectile;
+
+/**
+* Launch event for one projectile simulated by UGSProjectileSubsystem. Clients simulate the projectile from this and
+* only correct it when the Server reports the impact.
+*/
+USTRUCT()
+struct GASSHOOTER_API FGSReplicatedProjectile : public FFastArraySerializerItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 ProjectileId;
+
+	UPROPERTY()
+	TSubclassOf<AGSProjectile> ProjectileClass;
+
+	UPROPERTY()
+	FVector_NetQuantize Origin;
+
+	// Rounded to 1cm/s
+	UPROPERTY()
+	FVector_NetQuantize Velocity;
+
+	// Server world time of the launch. Clients fast forward by how long ago that was.
+	UPROPERTY()
+	float LaunchServerTime;
+
+	// For cosmetic randomness that should look the same everywhere
+	UPROPERTY()
+	int32 Seed;
+
+	// Ignored by the client side sweep
+	UPROPERTY()
+	AActor* InstigatorActor;
+
+	UPROPERTY()
+	bool bImpacted;
+
+	UPROPERTY()
+	FVector_NetQuantize ImpactLocation;
+
+	UPROPERTY()
+	FVector_NetQuantizeNormal ImpactNormal;
+
+	// Server only. When the event is dropped from the array.
+	UPROPERTY(NotReplicated)
+	float RemoveTime;
+
+	FGSReplicatedProjectile() : ProjectileId(INDEX_NONE), ProjectileClass(nullptr), Origin(ForceInitToZero), Velocity(ForceInitToZero),
+		LaunchServerTime(0.0f), Seed(0), InstigatorActor(nullptr), bImpacted(false), ImpactLocation(ForceInitToZero), ImpactNormal(ForceInitToZero),
+		RemoveTime(0.0f)
+	{
+	}
+
+	void PreReplicatedRemove(const struct FGSReplicatedProjectileArray& InArraySerializer);
+	void PostReplicatedAdd(const struct FGSReplicatedProjectileArray& InArraySerializer);
+	void PostReplicatedChange(const struct FGSReplicatedProjectileArray& InArraySerializer);
+};
+
+USTRUCT()
+struct GASSHOOTER_API FGSReplicatedProjectileArray : public FFastArraySerializer
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<FGSReplicatedProjectile> Projectiles;
+
+	UPROPERTY(NotReplicated)
+	class AGSProjectileReplicator* Owner;
+
+	FGSReplicatedProjectileArray() : Owner(nullptr)
+	{
+	}
+
+	bool NetDeltaSerialize(FNetDeltaSerializeInfo& DeltaParms)
+	{
+		return FFastArraySerializer::FastArrayDeltaSerialize<FGSReplicatedProjectile, FGSReplicatedProjectileArray>(Projectiles, DeltaParms, *this);
+	}
+};
+
+template<>
+struct TStructOpsTypeTraits<FGSReplicatedProjectileArray> : public TStructOpsTypeTraitsBase2<FGSReplicatedProjectileArray>
+{
+	enum
+	{
+		WithNetDeltaSerializer = true,
+	};
+};
+
+/**
+* Replicates every projectile launched through UGSProjectileSubsystem on one always relevant Actor channel as compact
+* launch and impact events instead of one Actor channel with movement replication per projectile.
+* Spawned by UGSProjectileSubsystem on the Server.
+*/
+UCLASS(NotBlueprintable, NotPlaceable)
+class GASSHOOTER_API AGSProjectileReplicator : public AActor
+{
+	GENERATED_BODY()
+
+public:
+	AGSProjectileReplicator();
+
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
+	virtual void Tick(float DeltaSeconds) override;
+
+	// Server only
+	void AddProjectile(int32 ProjectileId, UClass* ProjectileClass, const FVector& Origin, const FVector& Velocity, int32 Seed, AActor* InstigatorActor);
+
+	// Server only. Clients that are still simulating the projectile snap its impact to this hit.
+	void NotifyImpact(int32 ProjectileId, const FHitResult& Hit);
+
+	// Server only. The projectile expired without hitting anything.
+	void NotifyExpired(int32 ProjectileId);
+
+protected:
+	friend struct FGSReplicatedProjectile;
+
+	UPROPERTY(Replicated)
+	FGSReplicatedProjectileArray ReplicatedProjectiles;
+
+	// Seconds that an impact stays in the array so that clients get it through property replication
+	float ImpactLingerTime;
+
+	FGSReplicatedProjectile* FindProjectile(int32 ProjectileId);
+
+	float GetServerWorldTime() const;
+
+	class UGSProjectileSubsystem* GetProjectileSubsystem() const;
+
+	// Client side handlers for the array callbacks
+	void OnProjectileAdded(const FGSReplicatedProjectile& Projectile);
+	void OnProjectileChanged(const FGSReplicatedProjectile& Projectile);
+	void OnProjectileRemoved(const FGSReplicatedProjectile& Projectile);
+};
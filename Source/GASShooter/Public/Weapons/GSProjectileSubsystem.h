@@ -0,0 +1,173 @@
+// Copyright 2020 Dan Kestranek.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Characters/Abilities/GSAbilityTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "Tickable.h"
+#include "GSProjectileSubsystem.generated.h"
+
+class AGSProjectile;
+class AGSProjectileReplicator;
+
+DECLARE_MULTICAST_DELEGATE_TwoParams(FGSProjectileImpactDelegate, int32 /*ProjectileId*/, const FHitResult& /*Hit*/);
+
+/**
+* Every live simulated projectile as a structure of arrays. Index i in every array is the same projectile.
+* Removing swaps the last projectile into the hole so that the arrays stay dense.
+*/
+USTRUCT()
+struct GASSHOOTER_API FGSProjectileArrays
+{
+	GENERATED_BODY()
+
+	TArray<int32> Ids;
+
+	TArray<FVector> Locations;
+
+	// Locations at the start of the last step. The sweep goes from here to Locations.
+	TArray<FVector> PreviousLocations;
+
+	TArray<FVector> Velocities;
+
+	TArray<float> GravityZ;
+
+	TArray<float> Radii;
+
+	TArray<float> LifeRemaining;
+
+	TArray<int32> Seeds;
+
+	TArray<TWeakObjectPtr<AActor>> Instigators;
+
+	TArray<FGSGameplayEffectContainerSpec> EffectContainerSpecs;
+
+	UPROPERTY()
+	TArray<UClass*> Classes;
+
+	// Pooled visual Actor for each projectile. Null when it isn't materialized.
+	UPROPERTY()
+	TArray<AGSProjectile*> Visuals;
+
+	int32 Num() const
+	{
+		return Ids.Num();
+	}
+
+	int32 Add(int32 Id, UClass* ProjectileClass, const FVector& Location, const FVector& Velocity, float InGravityZ, float Radius, float LifeSpan,
+		int32 Seed, AActor* Instigator, const FGSGameplayEffectContainerSpec& EffectContainerSpec);
+
+	void RemoveAtSwap(int32 Index);
+
+	void Empty();
+};
+
+USTRUCT()
+struct GASSHOOTER_API FGSProjectileVisualPool
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	TArray<AGSProjectile*> FreeProjectiles;
+
+	// Always hidden instance that runs the impact logic where there is no local viewer, e.g. on dedicated servers
+	UPROPERTY()
+	AGSProjectile* ImpactHandler;
+
+	FGSProjectileVisualPool() : ImpactHandler(nullptr)
+	{
+	}
+};
+
+/**
+* Simulates projectiles in bulk instead of every projectile being an Actor with its own ProjectileMovementComponent.
+* All projectiles are integrated in one batch per frame (in parallel when there are many) and then swept against the
+* world. AGSProjectile Actors are only used as pooled visuals near the local player and to run the impact logic, so
+* launching and hitting never spawns or destroys an Actor once the pool is warm.
+*
+* On the Server, launches and impacts are replicated as compact events through AGSProjectileReplicator. Clients run the
+* same simulation from the launch event, show their own predicted impacts and snap to the Server's impact if they are
+* still simulating the projectile when it arrives. GS.Projectiles.ReplicationMode 1 replicates an Actor per projectile
+* instead, for bandwidth comparisons with GS.Projectiles.ReplicationReport.
+*/
+UCLASS()
+class GASSHOOTER_API UGSProjectileSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	UGSProjectileSubsystem();
+
+	virtual void Deinitialize() override;
+
+	// FTickableGameObject
+	virtual void Tick(float DeltaTime) override;
+	virtual bool IsTickable() const override;
+	virtual TStatId GetStatId() const override;
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/**
+	* Starts simulating a projectile with the speed, gravity and radius of ProjectileClass's defaults. Returns its id.
+	* EffectContainerSpec is handed to the Actor that runs the impact logic, which adds the hit targets and applies it.
+	*/
+	UFUNCTION(BlueprintCallable, Category = "GASShooter|Projectile")
+	int32 LaunchProjectile(TSubclassOf<AGSProjectile> ProjectileClass, FVector Location, FRotator Rotation, AActor* InstigatorActor, const FGSGameplayEffectContainerSpec& EffectContainerSpec);
+
+	UFUNCTION(BlueprintCallable, Category = "GASShooter|Projectile")
+	int32 GetNumProjectiles() const;
+
+	// Client only. Starts simulating a projectile that the Server launched ElapsedTime seconds ago.
+	void SimulateReplicatedProjectile(int32 ProjectileId, UClass* ProjectileClass, const FVector& Origin, const FVector& Velocity, float ElapsedTime, int32 Seed, AActor* InstigatorActor);
+
+	// Client only. Runs the impact at the Server's hit if we are still simulating the projectile.
+	void ReconcileImpact(int32 ProjectileId, const FHitResult& Hit);
+
+	// Stops simulating a projectile without an impact
+	void StopProjectile(int32 ProjectileId);
+
+	// Broadcast after the impact logic of a projectile ran
+	FGSProjectileImpactDelegate OnProjectileImpact;
+
+protected:
+	UPROPERTY()
+	FGSProjectileArrays Projectiles;
+
+	UPROPERTY()
+	TMap<UClass*, FGSProjectileVisualPool> VisualPools;
+
+	UPROPERTY()
+	AGSProjectileReplicator* Replicator;
+
+	int32 NextProjectileId;
+
+	// Spawns the replicator on the first launch on a Server
+	AGSProjectileReplicator* GetReplicator();
+
+	int32 AddProjectile(int32 ProjectileId, UClass* ProjectileClass, const FVector& Location, const FVector& Velocity, int32 Seed,
+		AActor* InstigatorActor, const FGSGameplayEffectContainerSpec& EffectContainerSpec);
+
+	void Integrate(float DeltaTime);
+
+	// Sweeps every projectile along its last step, resolves impacts and expiry and moves the visuals
+	void SweepProjectiles();
+
+	void ResolveImpact(int32 Index, const FHitResult& Hit);
+
+	// Returns false if there is no local viewer close enough to see the projectile
+	bool ShouldMaterializeVisual(const FVector& Location, const FVector& ViewLocation, bool bHasViewer) const;
+
+	bool GetLocalViewLocation(FVector& OutViewLocation) const;
+
+	AGSProjectile* AcquireVisual(int32 Index, const FVector& Location, const FRotator& Rotation);
+
+	AGSProjectile* GetImpactHandler(int32 Index, const FVector& Location, const FRotator& Rotation);
+
+	// Spawns a local, non-replicated instance for the subsystem to move
+	AGSProjectile* SpawnLocalProjectile(UClass* ProjectileClass, const FVector& Location, const FRotator& Rotation);
+
+	// ReplicationMode 1 only. A replicated Actor that follows the simulation, like projectiles did before this subsystem.
+	AGSProjectile* SpawnReplicatedVisual(int32 Index, const FVector& Location, const FRotator& Rotation);
+
+	void ReleaseVisual(AGSProjectile* Projectile);
+};
@@ -21,6 +21,18 @@ class UGSGameplayAbility;
 class UPaperSprite;
 class USkeletalMeshComponent;
 
+// Drives the weapon's net dormancy and update rate
+UENUM()
+enum class EGSWeaponNetState : uint8
+{
+	// In the world as a pickup. Fully dormant until someone picks it up.
+	Dropped,
+	// In an inventory but not in hands. Dormant, only flushed when the ammo changes.
+	Holstered,
+	// In hands. Awake at EquippedNetUpdateFrequency.
+	Equipped
+};
+
 UCLASS(Blueprintable, BlueprintType)
 class GASSHOOTER_API AGSWeapon : public AActor, public IAbilitySystemInterface
 {
@@ -163,11 +175,11 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "GASShooter|GSWeapon")
 	FText GetDefaultStatusText() const;
 
-	// Getter for LineTraceTargetActor. Spawns it if it doesn't exist yet.
+	// Getter for LineTraceTargetActor. Leases it from the world's TargetActor pool if we don't have one yet.
 	UFUNCTION(BlueprintCallable, Category = "GASShooter|Targeting")
 	AGSGATA_LineTrace* GetLineTraceTargetActor();
 
-	// Getter for SphereTraceTargetActor. Spawns it if it doesn't exist yet.
+	// Getter for SphereTraceTargetActor. Leases it from the world's TargetActor pool if we don't have one yet.
 	UFUNCTION(BlueprintCallable, Category = "GASShooter|Targeting")
 	AGSGATA_SphereTrace* GetSphereTraceTargetActor();
 
@@ -227,6 +239,24 @@ protected:
 	UPROPERTY(BlueprintReadOnly, Replicated, Category = "GASShooter|GSWeapon")
 	AGSHeroCharacter* OwningCharacter;
 
+	// Server only
+	UPROPERTY(VisibleInstanceOnly, Category = "GASShooter|GSWeapon|Replication")
+	EGSWeaponNetState NetState;
+
+	UPROPERTY(EditDefaultsOnly, Category = "GASShooter|GSWeapon|Replication")
+	float EquippedNetUpdateFrequency;
+
+	// Only used if the project turns on net.UseAdaptiveNetUpdateFrequency, which is off by default. Adaptive net update
+	// frequency will then slow down to this when nothing on the equipped weapon is changing.
+	UPROPERTY(EditDefaultsOnly, Category = "GASShooter|GSWeapon|Replication")
+	float EquippedMinNetUpdateFrequency;
+
+	UPROPERTY(EditDefaultsOnly, Category = "GASShooter|GSWeapon|Replication")
+	float HolsteredNetUpdateFrequency;
+
+	UPROPERTY(EditDefaultsOnly, Category = "GASShooter|GSWeapon|Replication")
+	float DroppedNetUpdateFrequency;
+
 	UPROPERTY(EditAnywhere, Category = "GASShooter|GSWeapon")
 	TArray<TSubclassOf<UGSGameplayAbility>> Abilities;
 
@@ -262,6 +292,15 @@ protected:
 	// Called when the player picks up this weapon
 	virtual void PickUpOnTouch(AGSHeroCharacter* InCharacter);
 
+	// Returns any leased TargetActors to the world's TargetActor pool
+	virtual void ReturnTargetActors();
+
+	// Switches dormancy and update rate for the new state and sends what changed with the transition. Server only.
+	virtual void SetNetState(EGSWeaponNetState NewNetState);
+
+	// Dormant weapons only replicate ammo changes when we flush them
+	void FlushAmmoNetDormancy();
+
 	UFUNCTION()
 	virtual void OnRep_PrimaryClipAmmo(int32 OldPrimaryClipAmmo);
 